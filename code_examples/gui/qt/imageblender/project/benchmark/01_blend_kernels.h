@@ -0,0 +1,123 @@
+#pragma once
+
+#include "blend_kernels.h"
+#include "tint.h"
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Every blend mode on a 4096 x 4096 image: QPainter::fillRect against the scalar, SSE2 and AVX2
+// kernels. Each kernel is first checked against the QPainter result, the largest difference of any
+// channel is printed next to its speed. "-" marks an ISA the CPU lacks or the mode has no kernel for.
+// Two images: an opaque photo-like one (the table path) and one with random alpha and transparent
+// pixels (the arithmetic path).
+class Benchmark_01_Blend_Kernels {
+public:
+    void Run() {
+        std::printf("\n🚀 Blend kernels: %d x %d, color #%08x, %s\n", kSize, kSize, kColor.rgba(),
+                    blend::isaName(blend::bestIsa()));
+        for (bool opaque : {true, false}) {
+            QImage source = makeImage(opaque);
+            std::printf("\n%s image\n", opaque ? "opaque" : "translucent");
+            std::printf("%-12s %12s %12s %12s %12s   %s\n", "mode", "QPainter", "scalar", "SSE2", "AVX2", "max diff");
+            for (blend::Mode mode : blend::kAllModes) {
+                runMode(source, mode);
+            }
+        }
+    }
+
+private:
+    static constexpr int kSize = 4096;
+    static constexpr int kRepeats = 5;
+    inline static const QColor kColor = QColor(255, 200, 40, 100);
+
+    static QPainter::CompositionMode compositionMode(blend::Mode mode) {
+        for (int m = QPainter::CompositionMode_SourceOver; m <= QPainter::CompositionMode_Exclusion; ++m) {
+            auto candidate = static_cast<QPainter::CompositionMode>(m);
+            if (blendModeFor(candidate) == mode) return candidate;
+        }
+        return QPainter::CompositionMode_SourceOver;
+    }
+
+    static QImage makeImage(bool opaque) {
+        QImage image(kSize, kSize, QImage::Format_ARGB32_Premultiplied);
+        std::mt19937 random(42);
+        for (int y = 0; y < image.height(); ++y) {
+            auto *line = reinterpret_cast<std::uint32_t *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                std::uint32_t value = random();
+                if (opaque) {
+                    line[x] = 0xff000000u | value;
+                } else {
+                    std::uint32_t alpha = value >> 24;
+                    line[x] = alpha < 16 ? 0 : blend::premultiply(value);
+                }
+            }
+        }
+        return image;
+    }
+
+    // Milliseconds of the fastest of kRepeats runs, every run starts from a fresh copy of the source.
+    template <typename Func>
+    static double fastest(const QImage &source, QImage &result, Func &&func) {
+        double best = 1e30;
+        for (int i = 0; i < kRepeats; ++i) {
+            result = source.copy();
+            auto start = std::chrono::steady_clock::now();
+            func(result);
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        return best;
+    }
+
+    static int maxDifference(const QImage &a, const QImage &b) {
+        int result = 0;
+        for (int y = 0; y < a.height(); ++y) {
+            const auto *lineA = reinterpret_cast<const std::uint32_t *>(a.constScanLine(y));
+            const auto *lineB = reinterpret_cast<const std::uint32_t *>(b.constScanLine(y));
+            for (int x = 0; x < a.width(); ++x) {
+                for (int shift = 0; shift < 32; shift += 8) {
+                    int diff = std::abs(static_cast<int>((lineA[x] >> shift) & 0xff) - static_cast<int>((lineB[x] >> shift) & 0xff));
+                    result = std::max(result, diff);
+                }
+            }
+        }
+        return result;
+    }
+
+    void runMode(const QImage &source, blend::Mode mode) {
+        TintSettings settings;
+        settings.color = kColor;
+        settings.opacity = kColor.alpha();
+        settings.mode = compositionMode(mode);
+
+        const double megapixels = static_cast<double>(kSize) * kSize / 1e6;
+        QImage reference;
+        double painterMs = fastest(source, reference, [&](QImage &image) { applyTintPainter(image, settings); });
+        std::printf("%-12s %7.0f MP/s", blend::modeName(mode), megapixels / painterMs * 1000.0);
+
+        int worst = 0;
+        for (blend::Isa isa : {blend::Isa::Scalar, blend::Isa::Sse2, blend::Isa::Avx2}) {
+            // not supported by the CPU, or the mode has no kernel for this ISA and would rerun a lower one
+            if (isa > blend::bestIsa() || blend::Kernel(mode, 0, isa).isa() < isa) {
+                std::printf(" %12s", "-");
+                continue;
+            }
+            QImage result;
+            double ms = fastest(source, result, [&](QImage &image) { applyTint(image, settings, isa); });
+            worst = std::max(worst, maxDifference(reference, result));
+            std::printf(" %7.0f MP/s", megapixels / ms * 1000.0);
+        }
+        std::printf("   %d%s\n", worst, worst > 1 ? "  <-- differs from QPainter" : "");
+    }
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "tint.h"
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QSize>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+// One export of a synthetic photo per size and format, split into its stages:
+//   decode  QImageReader from memory
+//   convert convertToFormat(ARGB32_Premultiplied), what the export did before tintInBands
+//   tint    tintInBands, the current export path (no full conversion)
+//   encode  QImageWriter to memory
+// Files are encoded in memory so the numbers are CPU time, not disk speed. MP/s is for
+// decode + tint + encode. Peak memory is the peak resident set size during the stages of one size
+// (Linux only, VmHWM is reset through /proc/self/clear_refs).
+class Benchmark_02_Export_Stages {
+public:
+    void Run() {
+        std::printf("\n🚀 Export stages: fastest of %d runs, color #%08x, SourceAtop\n", kRepeats, kColor.rgba());
+        std::printf("%-6s %-11s %9s %9s %9s %9s %11s %10s %12s\n", "format", "size", "decode", "convert", "tint",
+                    "encode", "MP/s", "file", "peak memory");
+
+        for (const QSize &size : {QSize(1024, 768), QSize(4000, 3000), QSize(8000, 5000)}) {
+            QImage photo = makePhoto(size, false);
+            run("jpg", photo);
+            photo = makePhoto(size, true);
+            run("png", photo);
+        }
+    }
+
+private:
+    static constexpr int kRepeats = 3;
+    inline static const QColor kColor = QColor(255, 200, 40, 100);
+
+    using Clock = std::chrono::steady_clock;
+
+    static double msSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Smooth gradients with a little noise: compresses like a photo, not like a flat test image.
+    static QImage makePhoto(const QSize &size, bool alpha) {
+        QImage image(size, alpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+        std::mt19937 random(7);
+        std::uniform_int_distribution<int> noise(-6, 6);
+        for (int y = 0; y < image.height(); ++y) {
+            auto *line = reinterpret_cast<std::uint32_t *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                int r = std::clamp(128 + static_cast<int>(100 * std::sin(x * 0.004)) + noise(random), 0, 255);
+                int g = std::clamp(y * 255 / image.height() + noise(random), 0, 255);
+                int b = std::clamp((x + y) * 255 / (image.width() + image.height()) + noise(random), 0, 255);
+                int a = alpha ? std::clamp(255 - x * 200 / image.width(), 0, 255) : 255;
+                line[x] = static_cast<std::uint32_t>(a) << 24 | static_cast<std::uint32_t>(r << 16 | g << 8 | b);
+            }
+        }
+        return image;
+    }
+
+    static void resetPeakMemory() {
+#ifdef __linux__
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+    }
+
+    // Peak resident set size in MB since the last reset, -1 when unknown.
+    static double peakMemoryMB() {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::stod(line.substr(6)) / 1024.0;
+            }
+        }
+#endif
+        return -1;
+    }
+
+    static QImage decode(QByteArray bytes, const char *format) {
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer, format);
+        reader.setAllocationLimit(kDecodeAllocationLimitMB);
+        return reader.read();
+    }
+
+    static QByteArray encode(const QImage &image, const char *format) {
+        QByteArray bytes;
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        QImageWriter writer(&buffer, format);
+        writer.write(image);
+        return bytes;
+    }
+
+    void run(const char *format, const QImage &photo) {
+        TintSettings settings;
+        settings.color = kColor;
+        settings.opacity = kColor.alpha();
+
+        const QByteArray file = encode(photo, format);
+        double decodeMs = 1e30, convertMs = 1e30, tintMs = 1e30, encodeMs = 1e30;
+
+        // decode -> tint -> encode as in the export pipeline
+        resetPeakMemory();
+        for (int i = 0; i < kRepeats; ++i) {
+            auto start = Clock::now();
+            QImage decoded = decode(file, format);
+            decodeMs = std::min(decodeMs, msSince(start));
+
+            start = Clock::now();
+            QImage tinted = tintInBands(std::move(decoded), settings);
+            tintMs = std::min(tintMs, msSince(start));
+
+            start = Clock::now();
+            QByteArray output = encode(tinted, format);
+            encodeMs = std::min(encodeMs, msSince(start));
+        }
+        const double peak = peakMemoryMB();
+
+        // Measured apart, the full conversion would count towards the peak memory
+        for (int i = 0; i < kRepeats; ++i) {
+            QImage decoded = decode(file, format);
+            auto start = Clock::now();
+            QImage converted = decoded.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            convertMs = std::min(convertMs, msSince(start));
+        }
+
+        const double megapixels = static_cast<double>(photo.width()) * photo.height() / 1e6;
+        char size[32];
+        std::snprintf(size, sizeof(size), "%dx%d", photo.width(), photo.height());
+        std::printf("%-6s %-11s %6.1f ms %6.1f ms %6.1f ms %6.1f ms %6.1f MP/s %7.1f MB", format, size, decodeMs,
+                    convertMs, tintMs, encodeMs, megapixels / (decodeMs + tintMs + encodeMs) * 1000.0,
+                    file.size() / 1e6);
+        if (peak >= 0) {
+            std::printf(" %9.0f MB\n", peak);
+        } else {
+            std::printf(" %12s\n", "n/a");
+        }
+    }
+};
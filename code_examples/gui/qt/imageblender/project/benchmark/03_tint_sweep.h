@@ -0,0 +1,74 @@
+#pragma once
+
+#include "tint.h"
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+// Every blend mode the blender offers at several opacities on a 12 MP photo: the QPainter path
+// (applyTintPainter, how the blender tinted before the blend kernels) against applyTint.
+// Opacity 0 and 255 take different branches in QPainter's solid fill, so they are measured as well.
+class Benchmark_03_Tint_Sweep {
+public:
+    void Run() {
+        QImage photo = makePhoto();
+        std::printf("\n🚀 Tint sweep: %d x %d opaque image, MP/s QPainter / blend kernel (%s)\n", photo.width(),
+                    photo.height(), blend::isaName(blend::bestIsa()));
+        std::printf("%-30s", "mode");
+        for (int opacity : kOpacities) {
+            std::printf("   opacity %-10d", opacity);
+        }
+        std::printf("\n");
+
+        for (const BlendModeOption &option : kBlendModeOptions) {
+            std::printf("%-30s", option.label);
+            for (int opacity : kOpacities) {
+                TintSettings settings;
+                settings.color = QColor(40, 120, 255);
+                settings.opacity = opacity;
+                settings.mode = option.mode;
+
+                double painter = megapixelsPerSecond(photo, [&](QImage &image) { applyTintPainter(image, settings); });
+                double kernel = megapixelsPerSecond(photo, [&](QImage &image) { applyTint(image, settings); });
+                std::printf("   %6.0f / %-6.0f   ", painter, kernel);
+            }
+            std::printf("\n");
+        }
+    }
+
+private:
+    static constexpr int kOpacities[] = {0, 64, 128, 255};
+    static constexpr int kRepeats = 3;
+
+    static QImage makePhoto() {
+        QImage image(4000, 3000, QImage::Format_ARGB32_Premultiplied);
+        std::mt19937 random(3);
+        for (int y = 0; y < image.height(); ++y) {
+            auto *line = reinterpret_cast<std::uint32_t *>(image.scanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                line[x] = 0xff000000u | (random() & 0xffffffu);
+            }
+        }
+        return image;
+    }
+
+    // Fastest of kRepeats runs, each on a fresh copy of the photo.
+    template <typename Func>
+    static double megapixelsPerSecond(const QImage &photo, Func &&func) {
+        double best = 1e30;
+        for (int i = 0; i < kRepeats; ++i) {
+            QImage image = photo.copy();
+            auto start = std::chrono::steady_clock::now();
+            func(image);
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        return static_cast<double>(photo.width()) * photo.height() / 1e6 / best;
+    }
+};
@@ -0,0 +1,36 @@
+#include <QGuiApplication>
+
+#include "01_blend_kernels.h"
+#include "02_export_stages.h"
+#include "03_tint_sweep.h"
+
+#include <cstdlib>
+
+// Build with the release preset. Pass a benchmark id to run a single one, 0 runs all of them.
+int main(int argc, char *argv[]) {
+    // No window is shown, but image plugins and fonts expect an application object.
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    int benchmarkId = 0;
+    if (argc > 1) {
+        benchmarkId = std::atoi(argv[1]);
+    }
+
+    if (benchmarkId == 0 || benchmarkId == 1) {
+        Benchmark_01_Blend_Kernels benchmark1;
+        benchmark1.Run();
+    }
+
+    if (benchmarkId == 0 || benchmarkId == 2) {
+        Benchmark_02_Export_Stages benchmark2;
+        benchmark2.Run();
+    }
+
+    if (benchmarkId == 0 || benchmarkId == 3) {
+        Benchmark_03_Tint_Sweep benchmark3;
+        benchmark3.Run();
+    }
+
+    return 0;
+}
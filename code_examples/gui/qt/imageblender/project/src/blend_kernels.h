@@ -0,0 +1,455 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define BLEND_KERNELS_X86 1
+#define BLEND_SSE2 __attribute__((target("sse2"), always_inline)) inline
+#define BLEND_AVX2 __attribute__((target("avx2"), always_inline)) inline
+#endif
+
+// Scanline kernels that blend one constant color over Format_ARGB32_Premultiplied pixels.
+// QPainter::fillRect runs the generic raster compositor: span generation, clipping and a composition
+// function called per span that re-reads the color every time. The tint always blends one color
+// over the whole image, so everything that depends only on the color is computed once here:
+// - opaque pixels (every pixel of a photo) look up each channel in a 256 entry table
+// - the separable modes are linear in the destination channel and its alpha, written as
+//   (p * d + q * da + r) / 255 with per-channel constants, and run with SSE2 or AVX2 on 16 bit lanes
+// - ColorBurn, ColorDodge and SoftLight divide per pixel, they use the table for opaque pixels and
+//   the scalar formula for the rest
+// The formulas are the ones of Qt's comp_func_solid_* functions, results match QPainter within +-1.
+namespace blend
+{
+    enum class Mode {
+        SourceOver, SourceAtop, Multiply, Screen, Overlay, Darken, Lighten,
+        ColorBurn, ColorDodge, HardLight, SoftLight, Difference
+    };
+
+    inline constexpr std::array<Mode, 12> kAllModes{
+        Mode::SourceOver, Mode::SourceAtop, Mode::Multiply, Mode::Screen, Mode::Overlay, Mode::Darken,
+        Mode::Lighten, Mode::ColorBurn, Mode::ColorDodge, Mode::HardLight, Mode::SoftLight, Mode::Difference};
+
+    inline const char *modeName(Mode mode) {
+        constexpr const char *kNames[] = {"SourceOver", "SourceAtop", "Multiply", "Screen", "Overlay", "Darken",
+                                          "Lighten", "ColorBurn", "ColorDodge", "HardLight", "SoftLight", "Difference"};
+        return kNames[static_cast<int>(mode)];
+    }
+
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    inline const char *isaName(Isa isa) {
+        return isa == Isa::Avx2 ? "AVX2" : isa == Isa::Sse2 ? "SSE2" : "scalar";
+    }
+
+    // The widest instruction set of this CPU.
+    inline Isa bestIsa() {
+#ifdef BLEND_KERNELS_X86
+        return __builtin_cpu_supports("avx2") ? Isa::Avx2 : Isa::Sse2;
+#else
+        return Isa::Scalar;
+#endif
+    }
+
+    namespace detail
+    {
+        constexpr int div255(int x) { return (x + (x >> 8) + 0x80) >> 8; }
+
+        constexpr int mixAlpha(int da, int sa) { return 255 - div255((255 - sa) * (255 - da)); }
+
+        // One color channel: destination d with alpha da, source s with alpha sa, all premultiplied.
+        inline int channel(Mode mode, int d, int da, int s, int sa) {
+            const int temp = s * (255 - da) + d * (255 - sa);
+            switch (mode) {
+            case Mode::SourceOver:
+                return s + div255(d * (255 - sa));
+            case Mode::SourceAtop:
+                return div255(s * da + d * (255 - sa));
+            case Mode::Multiply:
+                return div255(s * d + temp);
+            case Mode::Screen:
+                return 255 - div255((255 - s) * (255 - d));
+            case Mode::Overlay:
+                if (2 * d < da) return div255(2 * s * d + temp);
+                return div255(sa * da - 2 * (da - d) * (sa - s) + temp);
+            case Mode::Darken:
+                return s * da < d * sa ? div255(s * da + temp) : div255(d * sa + temp);
+            case Mode::Lighten:
+                return s * da > d * sa ? div255(s * da + temp) : div255(d * sa + temp);
+            case Mode::ColorBurn:
+                if (s * da + d * sa < sa * da) return div255(temp);
+                if (s == 0) return div255(d * sa + temp);
+                return div255(sa * (s * da + d * sa - sa * da) / s + temp);
+            case Mode::ColorDodge:
+                if (s * da + d * sa >= sa * da) return div255(sa * da + temp);
+                if (s == sa || sa == 0) return div255(temp);
+                return div255(255 * d * sa / (255 - 255 * s / sa) + temp);
+            case Mode::HardLight:
+                if (2 * s < sa) return div255(2 * s * d + temp);
+                return div255(sa * da - 2 * (da - d) * (sa - s) + temp);
+            case Mode::SoftLight: {
+                const int s2 = s << 1;
+                const int dnp = da != 0 ? (255 * d) / da : 0; // destination, not premultiplied
+                const int temp255 = temp * 255;
+                if (s2 < sa)
+                    return (d * (sa * 255 + (s2 - sa) * (255 - dnp)) + temp255) / 65025;
+                if (4 * d <= da)
+                    return (d * sa * 255 + da * (s2 - sa) * ((((16 * dnp - 12 * 255) * dnp + 3 * 65025) * dnp) / 65025) + temp255) / 65025;
+                return (d * sa * 255 + da * (s2 - sa) * (static_cast<int>(std::sqrt(static_cast<double>(dnp * 255))) - dnp) + temp255) / 65025;
+            }
+            case Mode::Difference: {
+                const int sda = s * da;
+                const int dsa = d * sa;
+                return s + d - div255(2 * (sda < dsa ? sda : dsa));
+            }
+            }
+            return d;
+        }
+
+        inline int alpha(Mode mode, int da, int sa) {
+            switch (mode) {
+            case Mode::SourceOver: return sa + div255(da * (255 - sa));
+            case Mode::SourceAtop: return da;
+            default: return mixAlpha(da, sa);
+            }
+        }
+
+        inline std::uint32_t pixel(Mode mode, std::uint32_t d, std::uint32_t color) {
+            const int da = static_cast<int>(d >> 24);
+            const int sa = static_cast<int>(color >> 24);
+            std::uint32_t result = static_cast<std::uint32_t>(alpha(mode, da, sa)) << 24;
+            for (int shift = 0; shift < 24; shift += 8) {
+                int value = channel(mode, (d >> shift) & 0xff, da, (color >> shift) & 0xff, sa);
+                result |= static_cast<std::uint32_t>(value < 0 ? 0 : value > 255 ? 255 : value) << shift;
+            }
+            return result;
+        }
+
+        // How the two linear terms of a lane are combined before the division by 255.
+        enum class Combine {
+            None,       // first term only
+            Select,     // first term where 2 * d < da (Overlay)
+            Min,        // Darken
+            Max,        // Lighten
+            Difference, // minimum, divided as 2 * x / 255 on the color lanes
+        };
+
+        // Per-lane constants of the vector kernels, in pixel byte order B, G, R, A and repeated for four
+        // pixels. A lane computes, in 16 bit arithmetic that may wrap in between:
+        //     x = combine(p1 * d + q1 * da + r1, p2 * d + q2 * da + r2)
+        //     result = s + (e & d) +- x / 255   (the sign is minus where n = 0xffff)
+        struct Lanes {
+            Combine combine = Combine::None;
+            alignas(32) std::uint16_t p1[16], q1[16], r1[16];
+            alignas(32) std::uint16_t p2[16], q2[16], r2[16];
+            alignas(32) std::uint16_t s[16], e[16], n[16], twice[16];
+        };
+
+        struct LaneTerm {
+            int p1 = 0, q1 = 0, r1 = 0, p2 = 0, q2 = 0, r2 = 0, s = 0;
+            bool e = false, n = false, twice = false;
+        };
+
+        inline LaneTerm laneTerm(Mode mode, int s, int sa, bool isAlpha) {
+            LaneTerm t;
+            auto only = [&t](int p, int q, int r) {
+                t.p1 = t.p2 = p;
+                t.q1 = t.q2 = q;
+                t.r1 = t.r2 = r;
+            };
+            if (isAlpha && mode != Mode::SourceOver && mode != Mode::SourceAtop) {
+                // mixAlpha: 255 - (255 - sa) * (255 - da) / 255
+                only(sa - 255, 0, 255 * (255 - sa));
+                t.s = 255;
+                t.n = true;
+                return t;
+            }
+            switch (mode) {
+            case Mode::SourceOver:
+                only(255 - sa, 0, 0);
+                t.s = s;
+                break;
+            case Mode::SourceAtop:
+                only(255 - sa, s, 0);
+                break;
+            case Mode::Multiply:
+                only(s + 255 - sa, -s, 255 * s);
+                break;
+            case Mode::Screen:
+                only(s - 255, 0, 255 * (255 - s));
+                t.s = 255;
+                t.n = true;
+                break;
+            case Mode::HardLight:
+            case Mode::Overlay:
+                t.p1 = 2 * s + 255 - sa; t.q1 = -s;     t.r1 = 255 * s; // 2 * s * d + temp
+                t.p2 = 255 + sa - 2 * s; t.q2 = s - sa; t.r2 = 255 * s; // sa * da - 2 * (da - d) * (sa - s) + temp
+                if (mode == Mode::HardLight) {
+                    if (2 * s < sa) only(t.p1, t.q1, t.r1);
+                    else only(t.p2, t.q2, t.r2);
+                }
+                break;
+            case Mode::Darken:
+            case Mode::Lighten:
+                t.p1 = 255 - sa; t.q1 = 0;  t.r1 = 255 * s; // s * da + temp
+                t.p2 = 255;      t.q2 = -s; t.r2 = 255 * s; // d * sa + temp
+                break;
+            case Mode::Difference:
+                t.p1 = 0;  t.q1 = s; t.r1 = 0; // s * da
+                t.p2 = sa; t.q2 = 0; t.r2 = 0; // d * sa
+                t.s = s;
+                t.e = true;
+                t.n = true;
+                t.twice = true;
+                break;
+            default:
+                break;
+            }
+            return t;
+        }
+
+        inline bool vectorizable(Mode mode) {
+            return mode != Mode::ColorBurn && mode != Mode::ColorDodge && mode != Mode::SoftLight;
+        }
+
+        inline Lanes makeLanes(Mode mode, std::uint32_t color) {
+            Lanes lanes;
+            lanes.combine = mode == Mode::Overlay ? Combine::Select
+                          : mode == Mode::Darken ? Combine::Min
+                          : mode == Mode::Lighten ? Combine::Max
+                          : mode == Mode::Difference ? Combine::Difference
+                                                     : Combine::None;
+            const int sa = static_cast<int>(color >> 24);
+            for (int lane = 0; lane < 16; ++lane) {
+                int channelIndex = lane % 4;
+                int s = static_cast<int>((color >> (8 * channelIndex)) & 0xff);
+                LaneTerm t = laneTerm(mode, s, sa, channelIndex == 3);
+                auto u16 = [](int v) { return static_cast<std::uint16_t>(v); }; // wraps negative constants
+                lanes.p1[lane] = u16(t.p1); lanes.q1[lane] = u16(t.q1); lanes.r1[lane] = u16(t.r1);
+                lanes.p2[lane] = u16(t.p2); lanes.q2[lane] = u16(t.q2); lanes.r2[lane] = u16(t.r2);
+                lanes.s[lane] = u16(t.s);
+                lanes.e[lane] = t.e ? 0xffff : 0;
+                lanes.n[lane] = t.n ? 0xffff : 0;
+                lanes.twice[lane] = t.twice ? 0xffff : 0;
+            }
+            return lanes;
+        }
+
+#ifdef BLEND_KERNELS_X86
+        struct Sse2Consts {
+            __m128i p1, q1, r1, p2, q2, r2, s, e, n, twice;
+        };
+
+        BLEND_SSE2 __m128i div255(__m128i x) {
+            x = _mm_add_epi16(x, _mm_srli_epi16(x, 8));
+            return _mm_srli_epi16(_mm_add_epi16(x, _mm_set1_epi16(0x80)), 8);
+        }
+
+        // 2 * x / 255 without leaving 16 bits: (x + ((x >> 7) + 128) / 2) >> 7.
+        BLEND_SSE2 __m128i div255Twice(__m128i x) {
+            __m128i half = _mm_srli_epi16(_mm_add_epi16(_mm_srli_epi16(x, 7), _mm_set1_epi16(128)), 1);
+            return _mm_srli_epi16(_mm_add_epi16(x, half), 7);
+        }
+
+        // Unsigned 16 bit minimum and maximum, SSE2 only has the signed ones.
+        BLEND_SSE2 __m128i minU16(__m128i a, __m128i b) {
+            const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+            return _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), bias);
+        }
+
+        BLEND_SSE2 __m128i maxU16(__m128i a, __m128i b) {
+            const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+            return _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias)), bias);
+        }
+
+        // Two pixels widened to 16 bit lanes.
+        template <Combine combine>
+        BLEND_SSE2 __m128i blendLanes(__m128i d, const Sse2Consts &k) {
+            __m128i da = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xff), 0xff);
+            __m128i x = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(k.p1, d), _mm_mullo_epi16(k.q1, da)), k.r1);
+            if constexpr (combine != Combine::None) {
+                __m128i x2 = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(k.p2, d), _mm_mullo_epi16(k.q2, da)), k.r2);
+                if constexpr (combine == Combine::Select) {
+                    __m128i first = _mm_cmplt_epi16(_mm_add_epi16(d, d), da);
+                    x = _mm_or_si128(_mm_and_si128(first, x), _mm_andnot_si128(first, x2));
+                } else if constexpr (combine == Combine::Max) {
+                    x = maxU16(x, x2);
+                } else {
+                    x = minU16(x, x2);
+                }
+            }
+            __m128i q = div255(x);
+            if constexpr (combine == Combine::Difference)
+                q = _mm_or_si128(_mm_and_si128(k.twice, div255Twice(x)), _mm_andnot_si128(k.twice, q));
+            q = _mm_sub_epi16(_mm_xor_si128(q, k.n), k.n);
+            return _mm_add_epi16(_mm_add_epi16(k.s, _mm_and_si128(k.e, d)), q);
+        }
+
+        template <Combine combine>
+        __attribute__((target("sse2"))) inline std::size_t blendSse2(const Lanes &lanes, std::uint32_t *pixels, std::size_t count) {
+            auto load = [](const std::uint16_t *v) { return _mm_load_si128(reinterpret_cast<const __m128i *>(v)); };
+            const Sse2Consts k{load(lanes.p1), load(lanes.q1), load(lanes.r1), load(lanes.p2), load(lanes.q2),
+                               load(lanes.r2), load(lanes.s), load(lanes.e), load(lanes.n), load(lanes.twice)};
+            const __m128i zero = _mm_setzero_si128();
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+                __m128i lo = blendLanes<combine>(_mm_unpacklo_epi8(v, zero), k);
+                __m128i hi = blendLanes<combine>(_mm_unpackhi_epi8(v, zero), k);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), _mm_packus_epi16(lo, hi));
+            }
+            return i;
+        }
+
+        struct Avx2Consts {
+            __m256i p1, q1, r1, p2, q2, r2, s, e, n, twice;
+        };
+
+        BLEND_AVX2 __m256i div255(__m256i x) {
+            x = _mm256_add_epi16(x, _mm256_srli_epi16(x, 8));
+            return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(0x80)), 8);
+        }
+
+        BLEND_AVX2 __m256i div255Twice(__m256i x) {
+            __m256i half = _mm256_srli_epi16(_mm256_add_epi16(_mm256_srli_epi16(x, 7), _mm256_set1_epi16(128)), 1);
+            return _mm256_srli_epi16(_mm256_add_epi16(x, half), 7);
+        }
+
+        // Four pixels widened to 16 bit lanes (unpack and pack work per 128 bit half, the order is kept).
+        template <Combine combine>
+        BLEND_AVX2 __m256i blendLanes(__m256i d, const Avx2Consts &k) {
+            __m256i da = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(d, 0xff), 0xff);
+            __m256i x = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(k.p1, d), _mm256_mullo_epi16(k.q1, da)), k.r1);
+            if constexpr (combine != Combine::None) {
+                __m256i x2 = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(k.p2, d), _mm256_mullo_epi16(k.q2, da)), k.r2);
+                if constexpr (combine == Combine::Select)
+                    x = _mm256_blendv_epi8(x2, x, _mm256_cmpgt_epi16(da, _mm256_add_epi16(d, d)));
+                else if constexpr (combine == Combine::Max)
+                    x = _mm256_max_epu16(x, x2);
+                else
+                    x = _mm256_min_epu16(x, x2);
+            }
+            __m256i q = div255(x);
+            if constexpr (combine == Combine::Difference)
+                q = _mm256_blendv_epi8(q, div255Twice(x), k.twice);
+            q = _mm256_sub_epi16(_mm256_xor_si256(q, k.n), k.n);
+            return _mm256_add_epi16(_mm256_add_epi16(k.s, _mm256_and_si256(k.e, d)), q);
+        }
+
+        template <Combine combine>
+        __attribute__((target("avx2"))) inline std::size_t blendAvx2(const Lanes &lanes, std::uint32_t *pixels, std::size_t count) {
+            const Avx2Consts k{
+                _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.p1)), _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.q1)),
+                _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.r1)), _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.p2)),
+                _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.q2)), _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.r2)),
+                _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.s)), _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.e)),
+                _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.n)), _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes.twice))};
+            const __m256i zero = _mm256_setzero_si256();
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+                __m256i lo = blendLanes<combine>(_mm256_unpacklo_epi8(v, zero), k);
+                __m256i hi = blendLanes<combine>(_mm256_unpackhi_epi8(v, zero), k);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels + i), _mm256_packus_epi16(lo, hi));
+            }
+            return i;
+        }
+#endif
+    }
+
+    // Qt's qPremultiply: every color channel times alpha / 255.
+    inline std::uint32_t premultiply(std::uint32_t argb) {
+        const int a = static_cast<int>(argb >> 24);
+        std::uint32_t result = argb & 0xff000000u;
+        for (int shift = 0; shift < 24; shift += 8)
+            result |= static_cast<std::uint32_t>(detail::div255(static_cast<int>((argb >> shift) & 0xff) * a)) << shift;
+        return result;
+    }
+
+    // Blends one premultiplied color over scanlines. Building a kernel computes the tables and lane
+    // constants, apply() may then be called from any number of threads.
+    class Kernel {
+    public:
+        Kernel(Mode mode, std::uint32_t premultipliedColor, Isa isa = bestIsa())
+            : m_mode(mode), m_color(premultipliedColor), m_lanes(detail::makeLanes(mode, premultipliedColor)) {
+            m_isa = detail::vectorizable(mode) ? isa : Isa::Scalar;
+#ifndef BLEND_KERNELS_X86
+            m_isa = Isa::Scalar;
+#endif
+            for (int c = 0; c < 3; ++c) {
+                for (int x = 0; x < 256; ++x) {
+                    std::uint32_t d = 0xff000000u | (static_cast<std::uint32_t>(x) << (8 * c));
+                    m_opaque[c][x] = static_cast<std::uint8_t>(detail::pixel(mode, d, m_color) >> (8 * c));
+                }
+            }
+            m_opaqueAlpha = detail::pixel(mode, 0xff000000u, m_color) & 0xff000000u;
+            m_transparent = detail::pixel(mode, 0, m_color);
+        }
+
+        Mode mode() const { return m_mode; }
+
+        // The instruction set actually used: the modes with a division per pixel are always scalar.
+        Isa isa() const { return m_isa; }
+
+        void apply(std::uint32_t *pixels, std::size_t count) const {
+            std::size_t done = 0;
+#ifdef BLEND_KERNELS_X86
+            if (m_isa == Isa::Avx2) done = dispatch<true>(pixels, count);
+            else if (m_isa == Isa::Sse2) done = dispatch<false>(pixels, count);
+#endif
+            applyScalar(pixels + done, count - done);
+        }
+
+    private:
+#ifdef BLEND_KERNELS_X86
+        template <bool avx2>
+        std::size_t dispatch(std::uint32_t *pixels, std::size_t count) const {
+            using detail::Combine;
+            switch (m_lanes.combine) {
+            case Combine::None: return run<avx2, Combine::None>(pixels, count);
+            case Combine::Select: return run<avx2, Combine::Select>(pixels, count);
+            case Combine::Min: return run<avx2, Combine::Min>(pixels, count);
+            case Combine::Max: return run<avx2, Combine::Max>(pixels, count);
+            case Combine::Difference: return run<avx2, Combine::Difference>(pixels, count);
+            }
+            return 0;
+        }
+
+        template <bool avx2, detail::Combine combine>
+        std::size_t run(std::uint32_t *pixels, std::size_t count) const {
+            if constexpr (avx2) return detail::blendAvx2<combine>(m_lanes, pixels, count);
+            else return detail::blendSse2<combine>(m_lanes, pixels, count);
+        }
+#endif
+
+        void applyScalar(std::uint32_t *pixels, std::size_t count) const {
+            // Locals: the compiler cannot know that the stores to pixels do not change the members.
+            const std::uint8_t *blue = m_opaque[0].data();
+            const std::uint8_t *green = m_opaque[1].data();
+            const std::uint8_t *red = m_opaque[2].data();
+            const std::uint32_t opaqueAlpha = m_opaqueAlpha;
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint32_t d = pixels[i];
+                if (d >= 0xff000000u) {
+                    pixels[i] = opaqueAlpha | blue[d & 0xff] | (std::uint32_t{green[(d >> 8) & 0xff]} << 8)
+                              | (std::uint32_t{red[(d >> 16) & 0xff]} << 16);
+                } else if (d == 0) {
+                    pixels[i] = m_transparent;
+                } else {
+                    pixels[i] = detail::pixel(m_mode, d, m_color);
+                }
+            }
+        }
+
+        Mode m_mode;
+        std::uint32_t m_color;
+        Isa m_isa = Isa::Scalar;
+        detail::Lanes m_lanes;
+        std::array<std::array<std::uint8_t, 256>, 3> m_opaque{};
+        std::uint32_t m_opaqueAlpha = 0;
+        std::uint32_t m_transparent = 0;
+    };
+}
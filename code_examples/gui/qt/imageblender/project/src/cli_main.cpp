@@ -0,0 +1,173 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QColor>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QStringList>
+
+#include "copy_counter.h"
+#include "export_pipeline.h"
+#include "tint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+// Headless batch mode: the same decode -> tint -> encode pipeline as the window, without a display.
+//   cppguide_examples_qt_imageblender_cli --color "#ffcc00" --mode multiply --opacity 128
+//       --output-dir out --suffix _tinted --format jpg --jpeg-quality 90 "assets/*.png" photos/
+
+namespace {
+
+const QStringList kImageFilters = {"*.png", "*.jpg", "*.jpeg", "*.bmp"};
+
+// Expands one input argument: a file, a directory (its images) or a wildcard in the file name
+// part ("assets/*.png"). Shells expand wildcards themselves, this covers quoted patterns and
+// build systems that pass arguments without a shell.
+QStringList expandInput(const QString &input) {
+    QFileInfo info(input);
+    if (info.isFile()) return {info.absoluteFilePath()};
+
+    QDir dir(input);
+    QStringList filters = kImageFilters;
+    if (!info.isDir()) {
+        dir = QDir(info.path());
+        filters = {info.fileName()};
+    }
+
+    QStringList files;
+    for (const QString &name : dir.entryList(filters, QDir::Files, QDir::Name)) {
+        files.append(dir.absoluteFilePath(name));
+    }
+    return files;
+}
+
+// The integer value of an option, false when it is not a number or outside min - max.
+bool parseInt(const QString &text, int min, int max, int &value) {
+    bool ok = false;
+    value = text.toInt(&ok);
+    return ok && value >= min && value <= max;
+}
+
+QString modeNames() {
+    QStringList names;
+    for (const BlendModeOption &option : kBlendModeOptions) {
+        names.append(option.name);
+    }
+    return names.join(", ");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("imageblender");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Tints images with a color and writes the results to an output folder.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("inputs", "Image files, folders or wildcards such as \"assets/*.png\".", "<inputs...>");
+
+    QCommandLineOption colorOption({"c", "color"}, "Tint color: #rrggbb or an SVG color name.", "color", "yellow");
+    QCommandLineOption modeOption({"m", "mode"}, "Blend mode: " + modeNames() + ".", "mode", kBlendModeOptions[0].name);
+    QCommandLineOption opacityOption({"a", "opacity"}, "Tint opacity, 0 - 255.", "opacity", "100");
+    QCommandLineOption outputOption({"o", "output-dir"}, "Output folder, default: a \"processed\" folder next to each image.", "dir");
+    QCommandLineOption suffixOption({"s", "suffix"}, "Appended to each output file name.", "suffix");
+    QCommandLineOption formatOption({"F", "format"}, "Output format such as png or jpg, default: the format of each source.", "format");
+    QCommandLineOption qualityOption("jpeg-quality", "JPEG quality, 0 - 100, default: 75.", "quality", "-1");
+    QCommandLineOption compressionOption("png-compression", "PNG compression level, 0 (fastest) - 9 (smallest).", "level", "-1");
+    QCommandLineOption threadsOption({"j", "threads"}, "Worker threads, default: one per core.", "count", "0");
+    QCommandLineOption forceOption({"f", "force"}, "Process every file, also those the export manifest reports as unchanged.");
+    QCommandLineOption statsOption("stats", "Print the full-image copies made per operation.");
+    QCommandLineOption quietOption({"q", "quiet"}, "Only print errors.");
+    parser.addOptions({colorOption, modeOption, opacityOption, outputOption, suffixOption, formatOption, qualityOption,
+                       compressionOption, threadsOption, forceOption, statsOption, quietOption});
+    parser.process(app);
+
+    TintSettings settings;
+    settings.color = QColor::fromString(parser.value(colorOption));
+    if (!settings.color.isValid()) {
+        std::fprintf(stderr, "Invalid color: %s\n", qPrintable(parser.value(colorOption)));
+        return 2;
+    }
+
+    std::optional<QPainter::CompositionMode> mode = compositionModeFromName(parser.value(modeOption));
+    if (!mode) {
+        std::fprintf(stderr, "Unknown blend mode: %s\nAvailable: %s\n", qPrintable(parser.value(modeOption)), qPrintable(modeNames()));
+        return 2;
+    }
+    settings.mode = *mode;
+
+    if (!parseInt(parser.value(opacityOption), 0, 255, settings.opacity)) {
+        std::fprintf(stderr, "Opacity must be 0 - 255: %s\n", qPrintable(parser.value(opacityOption)));
+        return 2;
+    }
+
+    ExportOptions options;
+    options.outputDir = parser.value(outputOption);
+    options.suffix = parser.value(suffixOption);
+    options.incremental = !parser.isSet(forceOption);
+    if (!parseInt(parser.value(threadsOption), 0, std::numeric_limits<int>::max(), options.threads)) {
+        std::fprintf(stderr, "Threads must be 0 (one per core) or more: %s\n", qPrintable(parser.value(threadsOption)));
+        return 2;
+    }
+
+    options.format = parser.value(formatOption).toLower().toLatin1();
+    if (!options.format.isEmpty() && !QImageWriter::supportedImageFormats().contains(options.format)) {
+        std::fprintf(stderr, "Unsupported output format: %s\n", options.format.constData());
+        return 2;
+    }
+    if (!parseInt(parser.value(qualityOption), -1, 100, options.jpegQuality)) {
+        std::fprintf(stderr, "JPEG quality must be 0 - 100, or -1 for the default: %s\n", qPrintable(parser.value(qualityOption)));
+        return 2;
+    }
+    if (!parseInt(parser.value(compressionOption), -1, 9, options.pngCompression)) {
+        std::fprintf(stderr, "PNG compression must be 0 - 9, or -1 for the default: %s\n", qPrintable(parser.value(compressionOption)));
+        return 2;
+    }
+
+    QStringList files;
+    for (const QString &input : parser.positionalArguments()) {
+        QStringList expanded = expandInput(input);
+        if (expanded.isEmpty()) {
+            std::fprintf(stderr, "No images match: %s\n", qPrintable(input));
+        }
+        files += expanded;
+    }
+    files.removeDuplicates();
+    if (files.isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    // Progress is reported from the worker threads, one line per tenth of the files.
+    const bool quiet = parser.isSet(quietOption);
+    std::mutex printMutex;
+    int lastReported = 0;
+    auto progress = [&](int done, int total) {
+        if (quiet) return;
+        std::lock_guard lock(printMutex);
+        if (done == total || done - lastReported >= std::max(1, total / 10)) {
+            lastReported = done;
+            std::fprintf(stderr, "%d / %d\n", done, total);
+        }
+    };
+
+    ExportResult result = ExportPipeline(settings, options).run(files, progress);
+
+    for (const QString &error : result.errors) {
+        std::fprintf(stderr, "error: %s\n", qPrintable(error));
+    }
+    if (!quiet) {
+        std::printf("Processed %d images, skipped %d unchanged, %d failed.\n", result.exported, result.skipped, result.failed);
+        if (result.renamed > 0) {
+            std::printf("%d files were renamed with '_copy' to avoid overwriting originals.\n", result.renamed);
+        }
+    }
+    if (parser.isSet(statsOption)) {
+        std::printf("%s\n", qPrintable(copycount::summary()));
+    }
+    return result.failed > 0 ? 1 : 0;
+}
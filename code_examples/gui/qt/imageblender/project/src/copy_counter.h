@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QImage>
+#include <QString>
+#include <QStringList>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Counts full-image copies per operation of the tint path.
+// QImage shares its pixels implicitly: assigning is free, but the first write to a shared image,
+// convertToFormat and converting formats that cannot be converted in place all allocate and fill a
+// new buffer of the full image. A CopyProbe remembers where the pixels of an image live and
+// counts a copy when they live somewhere else at the end of its scope, however it happened.
+// The counters are global and cheap (a few relaxed atomics per image), so they are always on;
+// summary() prints them, for example after an export.
+namespace copycount
+{
+    enum class Operation { ScaledDecode, PreviewTint, ExportTint, Count };
+
+    inline const char *operationName(Operation operation) {
+        constexpr const char *kNames[] = {"scaled decode", "preview tint", "export tint"};
+        return kNames[static_cast<int>(operation)];
+    }
+
+    struct Counter {
+        std::atomic<long long> operations{0};
+        std::atomic<long long> copies{0};
+        std::atomic<long long> bytes{0};
+    };
+
+    inline std::array<Counter, static_cast<std::size_t>(Operation::Count)> &counters() {
+        static std::array<Counter, static_cast<std::size_t>(Operation::Count)> instance;
+        return instance;
+    }
+
+    inline Counter &counter(Operation operation) {
+        return counters()[static_cast<std::size_t>(operation)];
+    }
+
+    inline void reset() {
+        for (Counter &c : counters()) {
+            c.operations = 0;
+            c.copies = 0;
+            c.bytes = 0;
+        }
+    }
+
+    // One line per operation that ran: "export tint: 12 images, 0 full-image copies (0.0 MB)".
+    inline QString summary() {
+        QStringList lines;
+        for (int i = 0; i < static_cast<int>(Operation::Count); ++i) {
+            const Counter &c = counters()[i];
+            if (c.operations == 0) continue;
+            lines.append(QString("%1: %2 images, %3 full-image copies (%4 MB)")
+                             .arg(operationName(static_cast<Operation>(i)))
+                             .arg(c.operations.load())
+                             .arg(c.copies.load())
+                             .arg(c.bytes.load() / 1e6, 0, 'f', 1));
+        }
+        return lines.join("\n");
+    }
+
+    class CopyProbe {
+    public:
+        CopyProbe(Operation operation, const QImage &image)
+            : m_counter(counter(operation)), m_image(image), m_bits(image.constBits()) {
+        }
+
+        ~CopyProbe() {
+            m_counter.operations.fetch_add(1, std::memory_order_relaxed);
+            if (m_bits && !m_image.isNull() && m_image.constBits() != m_bits) {
+                m_counter.copies.fetch_add(1, std::memory_order_relaxed);
+                m_counter.bytes.fetch_add(m_image.sizeInBytes(), std::memory_order_relaxed);
+            }
+        }
+
+        CopyProbe(const CopyProbe &) = delete;
+        CopyProbe &operator=(const CopyProbe &) = delete;
+
+    private:
+        Counter &m_counter;
+        const QImage &m_image;
+        const uchar *m_bits;
+    };
+}
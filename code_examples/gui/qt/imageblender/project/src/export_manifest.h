@@ -0,0 +1,140 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QString>
+
+#include <map>
+#include <mutex>
+
+// Remembers what every output file was made from, so an export can skip outputs that are current.
+// Each output folder gets a ".imageblender-manifest.json" with one entry per output file: the
+// source path, its size, modification time and SHA-1, and the settings key it was written with.
+// An output is current when its entry has the same source, settings and content hash and the file
+// still exists. Size and modification time are only a shortcut: when they match the file is not
+// hashed again, a touched but unchanged source is hashed and still skipped.
+// All functions may be called from several threads.
+class ExportManifest {
+public:
+    static constexpr const char *kFileName = ".imageblender-manifest.json";
+
+    struct Fingerprint {
+        qint64 size = -1;
+        qint64 modified = 0; // ms since epoch
+        QByteArray hash;     // hex, empty when the file could not be read
+    };
+
+    // Returns true when targetPath is current for sourcePath and settingsKey. Otherwise fingerprint
+    // is filled in for record() after the output was written.
+    bool isCurrent(const QString &sourcePath, const QString &targetPath, const QString &settingsKey,
+                   Fingerprint &fingerprint) {
+        QFileInfo sourceInfo(sourcePath);
+        fingerprint = {sourceInfo.size(), sourceInfo.lastModified().toMSecsSinceEpoch(), {}};
+
+        QFileInfo targetInfo(targetPath);
+        QJsonObject entry = find(targetInfo);
+        bool matches = !entry.isEmpty() && targetInfo.exists()
+            && entry["source"].toString() == sourceInfo.absoluteFilePath()
+            && entry["settings"].toString() == settingsKey;
+
+        if (matches && entry["size"].toInteger() == fingerprint.size
+            && entry["modified"].toInteger() == fingerprint.modified) {
+            return true;
+        }
+
+        fingerprint.hash = hashFile(sourcePath);
+        if (matches && !fingerprint.hash.isEmpty() && entry["sha1"].toString().toLatin1() == fingerprint.hash) {
+            record(sourcePath, targetPath, settingsKey, fingerprint); // remember the new modification time
+            return true;
+        }
+        return false;
+    }
+
+    void record(const QString &sourcePath, const QString &targetPath, const QString &settingsKey,
+                const Fingerprint &fingerprint) {
+        if (fingerprint.hash.isEmpty()) return;
+
+        QJsonObject entry;
+        entry["source"] = QFileInfo(sourcePath).absoluteFilePath();
+        entry["size"] = fingerprint.size;
+        entry["modified"] = fingerprint.modified;
+        entry["sha1"] = QString::fromLatin1(fingerprint.hash);
+        entry["settings"] = settingsKey;
+
+        QFileInfo targetInfo(targetPath);
+        std::lock_guard lock(m_mutex);
+        Folder &folder = load(targetInfo.absolutePath());
+        folder.entries[targetInfo.fileName()] = entry;
+        folder.dirty = true;
+    }
+
+    // Writes the manifests that changed. Returns false when one could not be written.
+    bool save() {
+        std::lock_guard lock(m_mutex);
+        bool ok = true;
+        for (auto &[path, folder] : m_folders) {
+            if (!folder.dirty) continue;
+
+            QJsonObject root;
+            root["version"] = 1;
+            root["entries"] = folder.entries;
+
+            QSaveFile file(QDir(path).filePath(kFileName));
+            if (file.open(QIODevice::WriteOnly)) {
+                file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+                folder.dirty = !file.commit();
+            }
+            ok = ok && !folder.dirty;
+        }
+        return ok;
+    }
+
+    static Fingerprint fingerprintOf(const QString &path) {
+        QFileInfo info(path);
+        return {info.size(), info.lastModified().toMSecsSinceEpoch(), hashFile(path)};
+    }
+
+    static QByteArray hashFile(const QString &path) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) return {};
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        if (!hash.addData(&file)) return {};
+        return hash.result().toHex();
+    }
+
+private:
+    struct Folder {
+        QJsonObject entries; // output file name -> entry
+        bool dirty = false;
+    };
+
+    QJsonObject find(const QFileInfo &targetInfo) {
+        std::lock_guard lock(m_mutex);
+        return load(targetInfo.absolutePath()).entries.value(targetInfo.fileName()).toObject();
+    }
+
+    // Called with the lock held. Reads the manifest of a folder the first time it is used.
+    Folder &load(const QString &folderPath) {
+        auto [it, inserted] = m_folders.try_emplace(folderPath);
+        if (inserted) {
+            QFile file(QDir(folderPath).filePath(kFileName));
+            if (file.open(QIODevice::ReadOnly)) {
+                QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+                if (root["version"].toInt() == 1) {
+                    it->second.entries = root["entries"].toObject();
+                }
+            }
+        }
+        return it->second;
+    }
+
+    std::mutex m_mutex;
+    std::map<QString, Folder> m_folders; // by absolute folder path
+};
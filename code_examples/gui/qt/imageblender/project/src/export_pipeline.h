@@ -0,0 +1,356 @@
+#pragma once
+
+#include "copy_counter.h"
+#include "export_manifest.h"
+#include "tint.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QSaveFile>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct ExportOptions {
+    QString outputDir; // empty: a "processed" folder next to each source file
+    QString suffix;    // appended to the base name, may be empty
+    int threads = 0;      // 0: one per core
+    int maxInFlight = 0;  // decoded images held at once, 0: two per thread
+    bool incremental = true; // skip outputs the manifest reports as current
+
+    // Encoder
+    QByteArray format;       // output format such as "png" or "jpg", empty: the format of the source
+    int jpegQuality = -1;    // 0 - 100, -1: Qt's default (75)
+    int pngCompression = -1; // zlib level, 0 (fastest) - 9 (smallest), -1: Qt's default
+};
+
+struct ExportResult {
+    int exported = 0;
+    int skipped = 0; // output already current
+    int renamed = 0; // written with "_copy" because the target was the source itself
+    int failed = 0;
+    bool canceled = false;
+    QStringList errors;
+};
+
+// Target path of one source file: <output folder>/<base name><suffix>.<extension>.
+// The folder is created when missing. When the target would overwrite the source the name gets
+// an extra "_copy" and renamed is set.
+inline QString exportTargetPath(const QString &filePath, const ExportOptions &options, bool *renamed = nullptr) {
+    QFileInfo sourceInfo(filePath);
+
+    QString finalOutputDir = options.outputDir.isEmpty()
+        ? sourceInfo.absolutePath() + "/processed"
+        : options.outputDir;
+
+    QDir dir(finalOutputDir);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+
+    QString extension = options.format.isEmpty() ? sourceInfo.suffix() : QString::fromLatin1(options.format);
+    QString newName = sourceInfo.baseName() + options.suffix + "." + extension;
+    QString targetPath = dir.filePath(newName);
+
+    // QFileInfo comparison handles standard path differences (e.g. / vs \)
+    bool collision = QFileInfo(targetPath) == QFileInfo(filePath);
+    if (collision) {
+        newName = sourceInfo.baseName() + options.suffix + "_copy." + extension;
+        targetPath = dir.filePath(newName);
+    }
+    if (renamed) *renamed = collision;
+    return targetPath;
+}
+
+// Everything besides the source that changes the output written to targetPath, recorded in the
+// export manifest. Only the encoder option of the target's format is part of it, so changing the
+// JPEG quality does not invalidate PNG outputs.
+inline QString exportSettingsKey(const TintSettings &settings, const ExportOptions &options, const QString &targetPath) {
+    QColor overlayColor = settings.color;
+    overlayColor.setAlpha(settings.opacity);
+    QString mode = QString::number(settings.mode);
+    for (const BlendModeOption &option : kBlendModeOptions) {
+        if (option.mode == settings.mode) mode = option.name;
+    }
+    QString key = overlayColor.name(QColor::HexArgb) + " " + mode;
+
+    QString format = QFileInfo(targetPath).suffix().toLower();
+    if (format == "jpg" || format == "jpeg") {
+        key += QString(" jpeg:%1").arg(options.jpegQuality);
+    } else if (format == "png") {
+        key += QString(" png:%1").arg(options.pngCompression);
+    }
+    return key;
+}
+
+// Encodes the image into a temporary file next to targetPath and renames it over targetPath once it
+// is complete (QSaveFile), so a crash or a full disk never leaves a truncated output behind.
+// The format follows the extension of targetPath.
+inline bool writeImage(const QImage &image, const QString &targetPath, const ExportOptions &options, QString &error) {
+    QByteArray format = QFileInfo(targetPath).suffix().toLower().toLatin1();
+
+    QSaveFile file(targetPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        error = targetPath + ": " + file.errorString();
+        return false;
+    }
+
+    QImageWriter writer(&file, format);
+    if (format == "jpg" || format == "jpeg") {
+        writer.setQuality(options.jpegQuality);
+    } else if (format == "png" && options.pngCompression >= 0) {
+        // The PNG writer maps quality 100 - 0 to zlib levels 0 - 9 as (100 - quality) * 9 / 91
+        writer.setQuality(100 - (std::min(options.pngCompression, 9) * 91 + 8) / 9);
+    }
+
+    if (!writer.write(image)) {
+        file.cancelWriting();
+        error = targetPath + ": " + writer.errorString();
+        return false;
+    }
+    if (!file.commit()) {
+        error = targetPath + ": " + file.errorString();
+        return false;
+    }
+    return true;
+}
+
+// Decode -> tint -> encode for a list of files on a pool of worker threads.
+// Images are tinted in bands (see tintInBands), so each one in flight costs one decoded copy.
+// Encoding runs on the same workers, several files are encoded at once.
+// With options.incremental, files whose output is current according to the export manifest are
+// skipped before they are decoded.
+// Target paths are worked out before the workers start. Two sources with the same target (a.jpg and
+// a.png exported as png, or equal names from different folders into one output folder) would
+// overwrite each other: only the first is exported, the others fail with an error.
+// Every worker takes the most advanced job available: encode before tint before decode. A new file
+// is only decoded while fewer than maxInFlight images are in the pipeline, so memory stays bounded
+// no matter how many files are exported, and finished images leave the pipeline as early as possible.
+// run() blocks until all files are done or the stop token is triggered; progress is reported from
+// the worker threads.
+class ExportPipeline {
+public:
+    using ProgressCallback = std::function<void(int done, int total)>;
+
+    ExportPipeline(const TintSettings &settings, const ExportOptions &options)
+        : m_settings(settings), m_options(options) {
+    }
+
+    ExportResult run(const QStringList &files, const ProgressCallback &progress = {}, std::stop_token stop = {}) {
+        m_files = files;
+        m_nextFile = 0;
+        m_inFlight = 0;
+        m_done = 0;
+        m_result = {};
+        m_tintQueue.clear();
+        m_encodeQueue.clear();
+        m_progress = progress;
+        m_stop = stop;
+        planTargets();
+
+        int threads = m_options.threads > 0 ? m_options.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        threads = std::min(threads, std::max(1, static_cast<int>(files.size())));
+        m_maxInFlight = m_options.maxInFlight > 0 ? m_options.maxInFlight : 2 * threads;
+
+        // Wake the workers when the caller cancels.
+        std::stop_callback onStop(stop, [this] {
+            std::lock_guard lock(m_mutex);
+            m_wake.notify_all();
+        });
+
+        {
+            std::vector<std::jthread> workers;
+            for (int i = 0; i < threads; ++i) {
+                workers.emplace_back([this] { work(); });
+            }
+        }
+
+        if (!m_manifest.save()) {
+            m_result.errors.append("The export manifest could not be written, the next export repeats these files.");
+        }
+        m_result.canceled = stop.stop_requested() && m_done < m_files.size();
+        return m_result;
+    }
+
+private:
+    struct Target {
+        QString path;
+        QString settingsKey;
+        bool renamed = false;
+        qsizetype sameAs = -1; // index of an earlier file with the same target, -1: none
+    };
+
+    struct Job {
+        int index = 0;
+        QImage image;
+        ExportManifest::Fingerprint fingerprint;
+    };
+
+    // Fills m_targets for m_files. Runs before the workers start, they only read it.
+    void planTargets() {
+        m_targets.clear();
+        m_targets.reserve(m_files.size());
+        QHash<QString, qsizetype> firstByPath;
+        for (qsizetype i = 0; i < m_files.size(); ++i) {
+            Target target;
+            target.path = exportTargetPath(m_files[i], m_options, &target.renamed);
+            target.settingsKey = exportSettingsKey(m_settings, m_options, target.path);
+
+            QString key = QFileInfo(target.path).absoluteFilePath();
+#if defined(Q_OS_WIN) || defined(Q_OS_MACOS)
+            key = key.toLower(); // case-insensitive file systems by default
+#endif
+            auto it = firstByPath.constFind(key);
+            if (it != firstByPath.constEnd()) {
+                target.sameAs = *it;
+            } else {
+                firstByPath.insert(key, i);
+            }
+            m_targets.push_back(std::move(target));
+        }
+    }
+
+    enum class Stage { Decode, Tint, Encode, Finished };
+    enum class Outcome { Next, Skipped, Exported, Failed };
+
+    void work() {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            Stage stage = Stage::Finished;
+            Job job;
+            m_wake.wait(lock, [&] {
+                if (m_stop.stop_requested() || m_done == m_files.size()) return true;
+                if (!m_encodeQueue.empty()) { stage = Stage::Encode; return true; }
+                if (!m_tintQueue.empty()) { stage = Stage::Tint; return true; }
+                if (m_nextFile < m_files.size() && m_inFlight < m_maxInFlight) { stage = Stage::Decode; return true; }
+                return false;
+            });
+            if (stage == Stage::Finished) return;
+
+            if (stage == Stage::Encode) {
+                job = std::move(m_encodeQueue.front());
+                m_encodeQueue.pop_front();
+            } else if (stage == Stage::Tint) {
+                job = std::move(m_tintQueue.front());
+                m_tintQueue.pop_front();
+            } else {
+                job.index = m_nextFile++;
+                ++m_inFlight;
+            }
+
+            lock.unlock();
+            QString error;
+            Outcome outcome = process(stage, job, error);
+            lock.lock();
+
+            if (outcome == Outcome::Next && stage == Stage::Decode) {
+                m_tintQueue.push_back(std::move(job));
+            } else if (outcome == Outcome::Next && stage == Stage::Tint) {
+                m_encodeQueue.push_back(std::move(job));
+            } else {
+                finish(outcome, error);
+            }
+            m_wake.notify_all();
+        }
+    }
+
+    // Runs one stage without holding the lock.
+    Outcome process(Stage stage, Job &job, QString &error) {
+        const QString &filePath = m_files[job.index];
+        const Target &target = m_targets[job.index];
+        switch (stage) {
+        case Stage::Decode: {
+            if (target.sameAs >= 0) {
+                error = filePath + ": not exported, " + m_files[target.sameAs] + " has the same output file " + target.path;
+                return Outcome::Failed;
+            }
+            if (m_options.incremental && m_manifest.isCurrent(filePath, target.path, target.settingsKey, job.fingerprint)) {
+                return Outcome::Skipped;
+            }
+
+            QImageReader reader(filePath);
+            reader.setAllocationLimit(kDecodeAllocationLimitMB);
+            job.image = reader.read();
+            if (job.image.isNull()) {
+                error = filePath + ": " + reader.errorString();
+                return Outcome::Failed;
+            }
+            return Outcome::Next;
+        }
+        case Stage::Tint: {
+            copycount::CopyProbe probe(copycount::Operation::ExportTint, job.image);
+            job.image = tintInBands(std::move(job.image), m_settings);
+            if (job.image.isNull()) {
+                error = filePath + ": not enough memory to tint the image";
+                return Outcome::Failed;
+            }
+            return Outcome::Next;
+        }
+        case Stage::Encode: {
+            if (!writeImage(job.image, target.path, m_options, error)) {
+                return Outcome::Failed;
+            }
+            job.image = QImage(); // release the pixels before taking the lock
+            if (job.fingerprint.hash.isEmpty()) {
+                job.fingerprint = ExportManifest::fingerprintOf(filePath); // not checked before decoding
+            }
+            m_manifest.record(filePath, target.path, target.settingsKey, job.fingerprint);
+            if (target.renamed) {
+                std::lock_guard lock(m_mutex);
+                ++m_result.renamed;
+            }
+            return Outcome::Exported;
+        }
+        case Stage::Finished:
+            break;
+        }
+        return Outcome::Failed;
+    }
+
+    // Called with the lock held when an image leaves the pipeline.
+    void finish(Outcome outcome, const QString &error) {
+        --m_inFlight;
+        ++m_done;
+        if (outcome == Outcome::Exported) {
+            ++m_result.exported;
+        } else if (outcome == Outcome::Skipped) {
+            ++m_result.skipped;
+        } else {
+            ++m_result.failed;
+            m_result.errors.append(error);
+        }
+        if (m_progress) m_progress(static_cast<int>(m_done), static_cast<int>(m_files.size()));
+    }
+
+    TintSettings m_settings;
+    ExportOptions m_options;
+    ExportManifest m_manifest;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    QStringList m_files;
+    std::vector<Target> m_targets;
+    qsizetype m_nextFile = 0;
+    qsizetype m_done = 0;
+    int m_inFlight = 0;
+    int m_maxInFlight = 0;
+    std::deque<Job> m_tintQueue;
+    std::deque<Job> m_encodeQueue;
+    ExportResult m_result;
+    ProgressCallback m_progress;
+    std::stop_token m_stop;
+};
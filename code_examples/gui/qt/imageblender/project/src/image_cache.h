@@ -0,0 +1,90 @@
+#pragma once
+
+#include "copy_counter.h"
+#include "tint.h"
+
+#include <QImage>
+#include <QImageReader>
+#include <QSize>
+#include <QString>
+
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+// Decodes a file scaled down to fit maxSize, as Format_ARGB32_Premultiplied. JPEG decoders scale
+// while decoding, other formats are decoded and scaled by the reader; small images are never
+// scaled up. Returns a null image when the file cannot be decoded.
+inline QImage readScaled(const QString &filePath, const QSize &maxSize) {
+    QImageReader reader(filePath);
+    reader.setAllocationLimit(kDecodeAllocationLimitMB);
+
+    QSize size = reader.size();
+    if (size.isValid() && maxSize.isValid()
+        && (size.width() > maxSize.width() || size.height() > maxSize.height())) {
+        reader.setScaledSize(size.scaled(maxSize, Qt::KeepAspectRatio));
+    }
+
+    QImage image = reader.read();
+    if (!image.isNull() && image.format() != QImage::Format_ARGB32_Premultiplied) {
+        copycount::CopyProbe probe(copycount::Operation::ScaledDecode, image);
+        image.convertTo(QImage::Format_ARGB32_Premultiplied); // in place for RGB32 and ARGB32
+    }
+    return image;
+}
+
+// Least recently used cache of decoded images, bounded by the bytes of pixel data it holds.
+// An image larger than the whole budget is not kept. Not thread safe, owned by one thread.
+class ImageCache {
+public:
+    explicit ImageCache(qint64 budgetBytes)
+        : m_budget(budgetBytes) {
+    }
+
+    // The image and marks it as most recently used, none when it is not cached.
+    std::optional<QImage> find(const QString &key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) return std::nullopt;
+        m_items.splice(m_items.begin(), m_items, it->second);
+        return it->second->second;
+    }
+
+    void insert(const QString &key, const QImage &image) {
+        remove(key);
+        if (image.sizeInBytes() > m_budget) return;
+
+        m_items.emplace_front(key, image);
+        m_index[key] = m_items.begin();
+        m_bytes += image.sizeInBytes();
+        evict();
+    }
+
+    void setBudget(qint64 budgetBytes) {
+        m_budget = budgetBytes;
+        evict();
+    }
+
+private:
+    using Item = std::pair<QString, QImage>;
+
+    void remove(const QString &key) {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) return;
+        m_bytes -= it->second->second.sizeInBytes();
+        m_items.erase(it->second);
+        m_index.erase(it);
+    }
+
+    void evict() {
+        while (m_bytes > m_budget && !m_items.empty()) {
+            QString key = m_items.back().first;
+            remove(key);
+        }
+    }
+
+    qint64 m_budget;
+    qint64 m_bytes = 0;
+    std::list<Item> m_items; // most recently used first
+    std::unordered_map<QString, std::list<Item>::iterator> m_index;
+};
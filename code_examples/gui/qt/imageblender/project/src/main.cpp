@@ -13,12 +13,24 @@
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QSlider>
+#include <QSpinBox>
 #include <QGroupBox>
 #include <QComboBox>
 #include <QLineEdit>
 #include <QCheckBox>
 #include <QStyleFactory>
 #include <QDir>
+#include <QIcon>
+#include <QProgressDialog>
+#include <QTimer>
+
+#include "export_pipeline.h"
+#include "preview_renderer.h"
+#include "thumbnail_loader.h"
+#include "tint.h"
+
+#include <cstdint>
+#include <thread>
 
 class MainWindow : public QMainWindow {
 
@@ -37,6 +49,7 @@ public:
 
         fileListWidget = new QListWidget(this);
         fileListWidget->setFixedHeight(100);
+        fileListWidget->setIconSize(kThumbnailSize);
         layout->addWidget(fileListWidget);
 
         // --- 2. Settings Section ---
@@ -60,19 +73,10 @@ public:
         auto *lblMode = new QLabel("Blend Mode:", this);
         blendModeCombo = new QComboBox(this);
         
-        blendModeCombo->addItem("Tint (Source Atop) - Default", QPainter::CompositionMode_SourceAtop);
-        blendModeCombo->addItem("Normal (Source Over)", QPainter::CompositionMode_SourceOver);
-        blendModeCombo->addItem("Multiply", QPainter::CompositionMode_Multiply);
-        blendModeCombo->addItem("Screen", QPainter::CompositionMode_Screen);
-        blendModeCombo->addItem("Overlay", QPainter::CompositionMode_Overlay);
-        blendModeCombo->addItem("Darken", QPainter::CompositionMode_Darken);
-        blendModeCombo->addItem("Lighten", QPainter::CompositionMode_Lighten);
-        blendModeCombo->addItem("Color Burn", QPainter::CompositionMode_ColorBurn);
-        blendModeCombo->addItem("Color Dodge", QPainter::CompositionMode_ColorDodge);
-        blendModeCombo->addItem("Hard Light", QPainter::CompositionMode_HardLight);
-        blendModeCombo->addItem("Soft Light", QPainter::CompositionMode_SoftLight);
-        blendModeCombo->addItem("Difference", QPainter::CompositionMode_Difference);
-        
+        for (const BlendModeOption &option : kBlendModeOptions) {
+            blendModeCombo->addItem(option.label, option.mode);
+        }
+
         modeRow->addWidget(lblMode);
         modeRow->addWidget(blendModeCombo);
         settingsLayout->addLayout(modeRow);
@@ -126,6 +130,33 @@ public:
         suffixRow->addWidget(suffixEdit);
         outputLayout->addLayout(suffixRow);
 
+        // Encoder Row: format conversion and compression, minimum of the spin boxes is Qt's default
+        auto *encoderRow = new QHBoxLayout();
+        formatCombo = new QComboBox(this);
+        formatCombo->addItem("Same as Source", QByteArray());
+        formatCombo->addItem("PNG", QByteArray("png"));
+        formatCombo->addItem("JPEG", QByteArray("jpg"));
+        formatCombo->addItem("BMP", QByteArray("bmp"));
+
+        jpegQualitySpin = new QSpinBox(this);
+        jpegQualitySpin->setRange(-1, 100);
+        jpegQualitySpin->setSpecialValueText("Default");
+        jpegQualitySpin->setValue(-1);
+
+        pngCompressionSpin = new QSpinBox(this);
+        pngCompressionSpin->setRange(-1, 9);
+        pngCompressionSpin->setSpecialValueText("Default");
+        pngCompressionSpin->setValue(-1);
+        pngCompressionSpin->setToolTip("0: fastest, 9: smallest files");
+
+        encoderRow->addWidget(new QLabel("Format:", this));
+        encoderRow->addWidget(formatCombo);
+        encoderRow->addWidget(new QLabel("JPEG Quality:", this));
+        encoderRow->addWidget(jpegQualitySpin);
+        encoderRow->addWidget(new QLabel("PNG Compression:", this));
+        encoderRow->addWidget(pngCompressionSpin);
+        outputLayout->addLayout(encoderRow);
+
         layout->addWidget(outputGroup);
 
         // --- 4. Preview Section ---
@@ -135,11 +166,30 @@ public:
         imagePreviewLabel->setAlignment(Qt::AlignCenter);
         imagePreviewLabel->setMinimumHeight(200);
         previewLayout->addWidget(imagePreviewLabel);
+
+        // Memory for decoded previews, so switching back to a file does not decode it again
+        auto *cacheRow = new QHBoxLayout();
+        previewCacheSpin = new QSpinBox(this);
+        previewCacheSpin->setRange(0, 4096);
+        previewCacheSpin->setSingleStep(64);
+        previewCacheSpin->setSuffix(" MB");
+        previewCacheSpin->setSpecialValueText("Off");
+        previewCacheSpin->setValue(static_cast<int>(kPreviewCacheBytes >> 20));
+        cacheRow->addWidget(new QLabel("Preview Cache:", this));
+        cacheRow->addWidget(previewCacheSpin);
+        cacheRow->addStretch();
+        previewLayout->addLayout(cacheRow);
         
         layout->addWidget(previewGroup);
 
+        // Slider ticks and other setting changes are coalesced to one preview render per frame
+        previewTimer = new QTimer(this);
+        previewTimer->setSingleShot(true);
+        previewTimer->setInterval(16);
+        connect(previewTimer, &QTimer::timeout, this, &MainWindow::renderPreview);
+
         // --- 5. Export Button ---
-        auto *btnExport = new QPushButton("Export All Files", this);
+        btnExport = new QPushButton("Export All Files", this);
         btnExport->setMinimumHeight(40);
         layout->addWidget(btnExport);
 
@@ -154,6 +204,9 @@ public:
         connect(fileListWidget, &QListWidget::itemSelectionChanged, this, &MainWindow::updatePreview);
         connect(blendModeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), 
                 this, &MainWindow::updatePreview);
+        connect(previewCacheSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int megabytes) {
+            m_previewRenderer.setCacheBudget(qint64(megabytes) << 20);
+        });
 
         // Update the 0-1 label when slider changes
         connect(opacitySlider, &QSlider::valueChanged, this, [this](int value){
@@ -189,11 +242,34 @@ private:
     QString m_customOutputDir;
     QCheckBox *suffixCheckBox;
     QLineEdit *suffixEdit;
+    QComboBox *formatCombo;
+    QSpinBox *jpegQualitySpin;
+    QSpinBox *pngCompressionSpin;
     
     QLabel *imagePreviewLabel;
-
-    QImage m_cachedImage;
-    QString m_cachedPath;
+    QSpinBox *previewCacheSpin;
+    QPushButton *btnExport;
+
+    // Export runs on its own thread, destroying the window cancels and joins it.
+    QProgressDialog *exportProgress = nullptr;
+    std::jthread m_exportThread;
+
+    // Preview renders and thumbnails run on their own threads, results come back as queued calls
+    static constexpr qint64 kPreviewCacheBytes = qint64(256) << 20; // initial value of previewCacheSpin
+    static constexpr QSize kThumbnailSize{32, 32};
+    static constexpr int kPrefetchRows = 2; // rows above and below the selection
+
+    QTimer *previewTimer;
+    PreviewRenderer m_previewRenderer{[this](std::uint64_t generation, const QImage &image) {
+        QMetaObject::invokeMethod(this, [this, generation, image] { showPreview(generation, image); },
+                                  Qt::QueuedConnection);
+    }, kPreviewCacheBytes};
+
+    std::uint64_t m_thumbnailGeneration = 0;
+    ThumbnailLoader m_thumbnailLoader{[this](std::uint64_t generation, int row, const QImage &image) {
+        QMetaObject::invokeMethod(this, [this, generation, row, image] { showThumbnail(generation, row, image); },
+                                  Qt::QueuedConnection);
+    }};
 
     void updateColorPreview() {
         QString style = QString("background-color: %1; border: 1px solid #555;").arg(selectedColor.name());
@@ -228,31 +304,33 @@ private:
         for (const QString &file : selectedFiles) {
             fileListWidget->addItem(file);
         }
-        
+        m_thumbnailGeneration = m_thumbnailLoader.load(selectedFiles, kThumbnailSize * devicePixelRatioF());
+
         if (fileListWidget->count() > 0) {
             fileListWidget->setCurrentRow(0);
         }
     }
 
-    void applyTintToImage(QImage &image) {
-        if (image.isNull()) return;
-
-        if (image.format() != QImage::Format_ARGB32_Premultiplied) {
-            image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
-        }
-
-        QPainter painter(&image);
-        QColor overlayColor = selectedColor;
-        overlayColor.setAlpha(opacitySlider->value());
+    TintSettings currentTintSettings() const {
+        TintSettings settings;
+        settings.color = selectedColor;
+        settings.opacity = opacitySlider->value();
+        settings.mode = static_cast<QPainter::CompositionMode>(blendModeCombo->currentData().toInt());
+        return settings;
+    }
 
-        auto mode = static_cast<QPainter::CompositionMode>(blendModeCombo->currentData().toInt());
-        painter.setCompositionMode(mode);
-        
-        painter.fillRect(image.rect(), overlayColor);
-        painter.end();
+    void resizeEvent(QResizeEvent *event) override {
+        QMainWindow::resizeEvent(event);
+        updatePreview(); // the proxy is sized to the label
     }
 
     void updatePreview() {
+        if (!previewTimer->isActive()) {
+            previewTimer->start();
+        }
+    }
+
+    void renderPreview() {
         if (selectedFiles.isEmpty()) {
             imagePreviewLabel->setText("No images loaded");
             return;
@@ -266,23 +344,43 @@ private:
             previewFile = selectedFiles.first();
         }
 
-        if (previewFile != m_cachedPath || m_cachedImage.isNull()) {
-            m_cachedImage.load(previewFile);
-            if (!m_cachedImage.isNull() && m_cachedImage.format() != QImage::Format_ARGB32_Premultiplied) {
-                m_cachedImage = m_cachedImage.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        QSize targetSize = imagePreviewLabel->size() * imagePreviewLabel->devicePixelRatioF();
+        m_previewRenderer.request(previewFile, targetSize, currentTintSettings());
+
+        // Decode the neighbours while the user looks at this one, nearest first
+        QStringList neighbours;
+        int row = fileListWidget->currentRow();
+        for (int distance = 1; row >= 0 && distance <= kPrefetchRows; ++distance) {
+            for (int neighbour : {row + distance, row - distance}) {
+                if (neighbour >= 0 && neighbour < fileListWidget->count()) {
+                    neighbours.append(fileListWidget->item(neighbour)->text());
+                }
             }
-            m_cachedPath = previewFile;
         }
+        m_previewRenderer.prefetch(neighbours, targetSize);
+    }
 
-        if (m_cachedImage.isNull()) return;
+    void showPreview(std::uint64_t generation, const QImage &image) {
+        if (generation != m_previewRenderer.generation()) return; // a newer render is on its way
 
-        QImage tempImg = m_cachedImage; 
-        applyTintToImage(tempImg);
+        if (image.isNull()) {
+            imagePreviewLabel->setText("Could not load image");
+            return;
+        }
+
+        QPixmap px = QPixmap::fromImage(image);
+        px.setDevicePixelRatio(imagePreviewLabel->devicePixelRatioF());
+        imagePreviewLabel->setPixmap(px);
+    }
 
-        QPixmap px = QPixmap::fromImage(tempImg);
-        imagePreviewLabel->setPixmap(px.scaled(imagePreviewLabel->size(), 
-                                        Qt::KeepAspectRatio, 
-                                        Qt::SmoothTransformation));
+    void showThumbnail(std::uint64_t generation, int row, const QImage &image) {
+        if (generation != m_thumbnailGeneration || image.isNull()) return;
+
+        if (QListWidgetItem *item = fileListWidget->item(row)) {
+            QPixmap px = QPixmap::fromImage(image);
+            px.setDevicePixelRatio(devicePixelRatioF());
+            item->setIcon(QIcon(px));
+        }
     }
 
     void processAndExport() {
@@ -290,61 +388,64 @@ private:
             QMessageBox::warning(this, "No Files", "Please select images first.");
             return;
         }
+        if (exportProgress) return; // an export is still running
 
-        // 1. Determine Suffix
-        QString suffix = "";
+        // 1. Determine Suffix and Output Directory
+        ExportOptions options;
         if (suffixCheckBox->isChecked()) {
-            suffix = suffixEdit->text();
+            options.suffix = suffixEdit->text();
         }
+        options.outputDir = m_customOutputDir;
+        options.format = formatCombo->currentData().toByteArray();
+        options.jpegQuality = jpegQualitySpin->value();
+        options.pngCompression = pngCompressionSpin->value();
+
+        // 2. Settings and file list are copied, the widgets may change while the export runs
+        TintSettings settings = currentTintSettings();
+        QStringList files = selectedFiles;
+
+        exportProgress = new QProgressDialog("Exporting images...", "Cancel", 0, files.size(), this);
+        exportProgress->setWindowModality(Qt::WindowModal);
+        exportProgress->setMinimumDuration(0);
+        exportProgress->setValue(0);
+        connect(exportProgress, &QProgressDialog::canceled, this, [this] {
+            m_exportThread.request_stop();
+        });
+        btnExport->setEnabled(false);
+
+        // 3. Decode, tint and encode on worker threads, results come back as queued calls
+        m_exportThread = std::jthread([this, settings, options, files](std::stop_token stop) {
+            ExportPipeline pipeline(settings, options);
+            auto progress = [this](int done, int total) {
+                QMetaObject::invokeMethod(this, [this, done, total] {
+                    if (exportProgress) {
+                        exportProgress->setMaximum(total);
+                        exportProgress->setValue(done);
+                    }
+                }, Qt::QueuedConnection);
+            };
+            ExportResult result = pipeline.run(files, progress, stop);
+            QMetaObject::invokeMethod(this, [this, result] { exportFinished(result); }, Qt::QueuedConnection);
+        });
+    }
 
-        int count = 0;
-        int skippedOrRenamed = 0;
-
-        for (const QString &filePath : selectedFiles) {
-            QImage finalImage(filePath);
-            if (finalImage.isNull()) continue;
-
-            applyTintToImage(finalImage);
-
-            QFileInfo sourceInfo(filePath);
-            
-            // 2. Determine Output Directory
-            QString finalOutputDir;
-            if (m_customOutputDir.isEmpty()) {
-                // Default: Create "processed" folder in source directory
-                finalOutputDir = sourceInfo.absolutePath() + "/processed";
-            } else {
-                finalOutputDir = m_customOutputDir;
-            }
-
-            // Ensure directory exists
-            QDir dir(finalOutputDir);
-            if (!dir.exists()) {
-                dir.mkpath(".");
-            }
-
-            // 3. Construct Filename
-            QString newName = sourceInfo.baseName() + suffix + "." + sourceInfo.suffix();
-            QString targetPath = dir.filePath(newName);
-
-            // 4. Overwrite Protection
-            // QFileInfo comparison handles standard path differences (e.g. / vs \)
-            if (QFileInfo(targetPath) == QFileInfo(filePath)) {
-                // Collision detected (Source == Destination)
-                // We enforce a safe suffix
-                newName = sourceInfo.baseName() + suffix + "_copy." + sourceInfo.suffix();
-                targetPath = dir.filePath(newName);
-                skippedOrRenamed++;
-            }
-
-            if (finalImage.save(targetPath)) {
-                count++;
-            }
+    void exportFinished(const ExportResult &result) {
+        if (exportProgress) {
+            exportProgress->deleteLater();
+            exportProgress = nullptr;
         }
+        btnExport->setEnabled(true);
 
-        QString msg = QString("Exported %1 images.").arg(count);
-        if (skippedOrRenamed > 0) {
-            msg += QString("\n\nNote: %1 files were renamed with '_copy' to avoid overwriting originals.").arg(skippedOrRenamed);
+        QString msg = QString("Processed %1 images, skipped %2 unchanged, %3 failed.")
+                          .arg(result.exported).arg(result.skipped).arg(result.failed);
+        if (result.canceled) {
+            msg = QString("Export canceled. ") + msg;
+        }
+        if (result.renamed > 0) {
+            msg += QString("\n\nNote: %1 files were renamed with '_copy' to avoid overwriting originals.").arg(result.renamed);
+        }
+        if (!result.errors.isEmpty()) {
+            msg += "\n\n" + result.errors.mid(0, 10).join("\n");
         }
 
         QMessageBox::information(this, "Done", msg);
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "image_cache.h"
+#include "tint.h"
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+// Renders the tinted preview on a background thread.
+// Sources are decoded straight into proxies that fit the label, so a slider tick only tints a few
+// hundred thousand pixels instead of the full image. Proxies are kept in an LRU cache bounded by
+// cacheBudgetBytes, and files the user is likely to select next can be decoded ahead of time with
+// prefetch(), so switching between previews does not wait for the decoder.
+// Only the newest request is kept: requests arriving while a render runs replace each other, and a
+// finished render is dropped when a newer request came in meanwhile. Prefetching only runs while
+// no request is pending.
+class PreviewRenderer {
+public:
+    // Called on the render thread. The image is null when the file could not be decoded.
+    using ResultCallback = std::function<void(std::uint64_t generation, const QImage &image)>;
+
+    explicit PreviewRenderer(ResultCallback onResult, qint64 cacheBudgetBytes = qint64(256) << 20)
+        : m_onResult(std::move(onResult)),
+          m_cache(cacheBudgetBytes),
+          m_thread([this](std::stop_token stop) { work(stop); }) {
+    }
+
+    // Queues a render and returns its generation, results of older generations are stale.
+    std::uint64_t request(const QString &filePath, const QSize &targetSize, const TintSettings &settings) {
+        std::lock_guard lock(m_mutex);
+        m_pending = Request{filePath, targetSize, settings, ++m_generation};
+        m_wake.notify_one();
+        return m_generation;
+    }
+
+    // Replaces the files to decode into the cache while idle, the first one is decoded first.
+    void prefetch(const QStringList &filePaths, const QSize &targetSize) {
+        std::lock_guard lock(m_mutex);
+        m_prefetch.clear();
+        for (const QString &filePath : filePaths) {
+            m_prefetch.emplace_back(filePath, targetSize);
+        }
+        m_wake.notify_one();
+    }
+
+    void setCacheBudget(qint64 budgetBytes) {
+        std::lock_guard lock(m_mutex);
+        m_cacheBudget = budgetBytes;
+        m_wake.notify_one();
+    }
+
+    std::uint64_t generation() const {
+        std::lock_guard lock(m_mutex);
+        return m_generation;
+    }
+
+private:
+    struct Request {
+        QString filePath;
+        QSize targetSize;
+        TintSettings settings;
+        std::uint64_t generation = 0;
+    };
+
+    void work(std::stop_token stop) {
+        std::stop_callback onStop(stop, [this] {
+            std::lock_guard lock(m_mutex);
+            m_wake.notify_all();
+        });
+
+        for (;;) {
+            std::optional<Request> request;
+            std::pair<QString, QSize> prefetch;
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [&] {
+                    return stop.stop_requested() || m_pending || !m_prefetch.empty() || m_cacheBudget;
+                });
+                if (stop.stop_requested()) return;
+                if (m_cacheBudget) {
+                    m_cache.setBudget(*m_cacheBudget);
+                    m_cacheBudget.reset();
+                }
+                if (m_pending) {
+                    request = std::move(m_pending);
+                    m_pending.reset();
+                } else if (!m_prefetch.empty()) {
+                    prefetch = std::move(m_prefetch.front());
+                    m_prefetch.pop_front();
+                } else {
+                    continue;
+                }
+            }
+
+            if (!request) {
+                proxy(prefetch.first, prefetch.second);
+                continue;
+            }
+
+            // The cache keeps the untinted proxy, applyTint detaches: one proxy sized copy per render
+            QImage image = proxy(request->filePath, request->targetSize);
+            if (isStale(request->generation)) continue;
+            {
+                copycount::CopyProbe probe(copycount::Operation::PreviewTint, image);
+                applyTint(image, request->settings);
+            }
+            if (isStale(request->generation)) continue;
+
+            m_onResult(request->generation, image);
+        }
+    }
+
+    // The untinted proxy of a file, decoded when it is not cached.
+    QImage proxy(const QString &filePath, const QSize &targetSize) {
+        QString key = QString("%1x%2 %3").arg(targetSize.width()).arg(targetSize.height()).arg(filePath);
+        if (std::optional<QImage> cached = m_cache.find(key)) return *cached;
+
+        QImage image = readScaled(filePath, targetSize);
+        if (!image.isNull()) m_cache.insert(key, image);
+        return image;
+    }
+
+    bool isStale(std::uint64_t generation) const {
+        std::lock_guard lock(m_mutex);
+        return generation != m_generation;
+    }
+
+    ResultCallback m_onResult;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::optional<Request> m_pending;
+    std::deque<std::pair<QString, QSize>> m_prefetch;
+    std::optional<qint64> m_cacheBudget; // new budget, applied by the render thread
+    std::uint64_t m_generation = 0;
+
+    ImageCache m_cache; // only touched by the render thread
+
+    std::jthread m_thread; // last member: started after everything it uses is constructed
+};
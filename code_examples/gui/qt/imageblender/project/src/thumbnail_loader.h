@@ -0,0 +1,85 @@
+#pragma once
+
+#include "image_cache.h"
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Decodes thumbnails for a file list on a few background threads, in list order.
+// load() replaces the list: files of the previous list that were not started yet are dropped, and
+// results of the previous list still being decoded are reported with their old generation.
+class ThumbnailLoader {
+public:
+    // Called on a loader thread. The image is null when the file could not be decoded.
+    using ResultCallback = std::function<void(std::uint64_t generation, int row, const QImage &image)>;
+
+    explicit ThumbnailLoader(ResultCallback onResult, int threads = 0)
+        : m_onResult(std::move(onResult)) {
+        if (threads <= 0) {
+            // Leave cores for the preview and the GUI thread
+            threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()) / 2, 1, 4);
+        }
+        for (int i = 0; i < threads; ++i) {
+            m_threads.emplace_back([this](std::stop_token stop) { work(stop); });
+        }
+    }
+
+    ~ThumbnailLoader() {
+        for (std::jthread &thread : m_threads) {
+            thread.request_stop();
+        }
+        std::lock_guard lock(m_mutex);
+        m_wake.notify_all();
+    }
+
+    std::uint64_t load(const QStringList &filePaths, const QSize &size) {
+        std::lock_guard lock(m_mutex);
+        m_files = filePaths;
+        m_size = size;
+        m_next = 0;
+        m_wake.notify_all();
+        return ++m_generation;
+    }
+
+private:
+    void work(std::stop_token stop) {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_wake.wait(lock, [&] { return stop.stop_requested() || m_next < m_files.size(); });
+            if (stop.stop_requested()) return;
+
+            int row = static_cast<int>(m_next++);
+            QString filePath = m_files[row];
+            QSize size = m_size;
+            std::uint64_t generation = m_generation;
+
+            lock.unlock();
+            QImage image = readScaled(filePath, size);
+            m_onResult(generation, row, image);
+            lock.lock();
+        }
+    }
+
+    ResultCallback m_onResult;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    QStringList m_files;
+    QSize m_size;
+    qsizetype m_next = 0;
+    std::uint64_t m_generation = 0;
+
+    std::vector<std::jthread> m_threads; // last member: started after everything it uses is constructed
+};
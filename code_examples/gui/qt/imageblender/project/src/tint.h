@@ -0,0 +1,172 @@
+#pragma once
+
+#include "blend_kernels.h"
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+
+#include <QString>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+// QImageReader refuses to allocate more than 256 MB per image by default, which is about an 8000 x 8000
+// photo. The readers of the blender raise it so large scans can be processed.
+inline constexpr int kDecodeAllocationLimitMB = 4096;
+
+// Everything the tint needs, copied out of the widgets so it can be used from worker threads.
+struct TintSettings {
+    QColor color = Qt::yellow;
+    int opacity = 100; // alpha of the overlay color, 0 - 255
+    QPainter::CompositionMode mode = QPainter::CompositionMode_SourceAtop;
+};
+
+// The composition modes the blender offers: command line name, label in the window, mode.
+struct BlendModeOption {
+    const char *name;
+    const char *label;
+    QPainter::CompositionMode mode;
+};
+
+inline constexpr BlendModeOption kBlendModeOptions[] = {
+    {"source-atop", "Tint (Source Atop) - Default", QPainter::CompositionMode_SourceAtop},
+    {"source-over", "Normal (Source Over)", QPainter::CompositionMode_SourceOver},
+    {"multiply", "Multiply", QPainter::CompositionMode_Multiply},
+    {"screen", "Screen", QPainter::CompositionMode_Screen},
+    {"overlay", "Overlay", QPainter::CompositionMode_Overlay},
+    {"darken", "Darken", QPainter::CompositionMode_Darken},
+    {"lighten", "Lighten", QPainter::CompositionMode_Lighten},
+    {"color-burn", "Color Burn", QPainter::CompositionMode_ColorBurn},
+    {"color-dodge", "Color Dodge", QPainter::CompositionMode_ColorDodge},
+    {"hard-light", "Hard Light", QPainter::CompositionMode_HardLight},
+    {"soft-light", "Soft Light", QPainter::CompositionMode_SoftLight},
+    {"difference", "Difference", QPainter::CompositionMode_Difference},
+};
+
+inline std::optional<QPainter::CompositionMode> compositionModeFromName(const QString &name) {
+    for (const BlendModeOption &option : kBlendModeOptions) {
+        if (name.compare(QLatin1String(option.name), Qt::CaseInsensitive) == 0) return option.mode;
+    }
+    return std::nullopt;
+}
+
+// The blend kernel of a composition mode, none for the modes the blender does not offer.
+inline std::optional<blend::Mode> blendModeFor(QPainter::CompositionMode mode) {
+    switch (mode) {
+    case QPainter::CompositionMode_SourceOver: return blend::Mode::SourceOver;
+    case QPainter::CompositionMode_SourceAtop: return blend::Mode::SourceAtop;
+    case QPainter::CompositionMode_Multiply: return blend::Mode::Multiply;
+    case QPainter::CompositionMode_Screen: return blend::Mode::Screen;
+    case QPainter::CompositionMode_Overlay: return blend::Mode::Overlay;
+    case QPainter::CompositionMode_Darken: return blend::Mode::Darken;
+    case QPainter::CompositionMode_Lighten: return blend::Mode::Lighten;
+    case QPainter::CompositionMode_ColorBurn: return blend::Mode::ColorBurn;
+    case QPainter::CompositionMode_ColorDodge: return blend::Mode::ColorDodge;
+    case QPainter::CompositionMode_HardLight: return blend::Mode::HardLight;
+    case QPainter::CompositionMode_SoftLight: return blend::Mode::SoftLight;
+    case QPainter::CompositionMode_Difference: return blend::Mode::Difference;
+    default: return std::nullopt;
+    }
+}
+
+// Fills the image with the overlay color using QPainter. This is the reference the blend kernels are
+// validated against, and the fallback for composition modes without a kernel.
+inline void applyTintPainter(QImage &image, const TintSettings &settings) {
+    if (image.isNull()) return;
+
+    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied); // in place for RGB32 and ARGB32
+    }
+
+    QPainter painter(&image);
+    QColor overlayColor = settings.color;
+    overlayColor.setAlpha(settings.opacity);
+
+    painter.setCompositionMode(settings.mode);
+    painter.fillRect(image.rect(), overlayColor);
+    painter.end();
+}
+
+// Fills the image with the overlay color using the composition mode of the settings, one scanline
+// at a time with the blend kernel of the mode (see blend_kernels.h).
+// QImage is reentrant, so this may run on any thread as long as every thread works on its own image.
+inline void applyTint(QImage &image, const TintSettings &settings, blend::Isa isa = blend::bestIsa()) {
+    if (image.isNull()) return;
+
+    std::optional<blend::Mode> mode = blendModeFor(settings.mode);
+    if (!mode) {
+        applyTintPainter(image, settings);
+        return;
+    }
+
+    if (image.format() != QImage::Format_ARGB32_Premultiplied) {
+        image.convertTo(QImage::Format_ARGB32_Premultiplied); // in place for RGB32 and ARGB32
+    }
+
+    QColor overlayColor = settings.color;
+    overlayColor.setAlpha(settings.opacity);
+    blend::Kernel kernel(*mode, blend::premultiply(overlayColor.rgba()), isa);
+
+    const int width = image.width();
+    for (int y = 0; y < image.height(); ++y) {
+        kernel.apply(reinterpret_cast<std::uint32_t *>(image.scanLine(y)), static_cast<std::size_t>(width));
+    }
+}
+
+// Tints a decoded image one band of rows at a time and returns it as Format_ARGB32 (with an alpha
+// channel) or Format_RGB32 (without), which the PNG and JPEG writers take as is.
+// applyTint converts the whole image to premultiplied ARGB first: for a 20000 x 20000 scan that is a
+// second 1.6 GB copy next to the decoded one, and the PNG writer converts back to ARGB32 in a third.
+// Here only one band (about 4 MB) is converted at a time. 32 bit images are tinted in place, other
+// formats (grayscale, indexed, 24 and 64 bit) are written into a new 32 bit image.
+// Pass the image with std::move, a shared image is copied before it is modified.
+// Returns a null image when the output or a band cannot be allocated.
+inline QImage tintInBands(QImage image, const TintSettings &settings, int bandRows = 0) {
+    if (image.isNull()) return image;
+
+    // Opaque pixels have the same bits in RGB32 and ARGB32_Premultiplied, and every blend kernel keeps
+    // them opaque: tint the decoded pixels directly, without bands. This is the common case, JPEG and
+    // PNG without alpha decode to RGB32.
+    if (image.format() == QImage::Format_RGB32 && blendModeFor(settings.mode)) {
+        QImage view(image.bits(), image.width(), image.height(), image.bytesPerLine(),
+                    QImage::Format_ARGB32_Premultiplied);
+        applyTint(view, settings);
+        return image;
+    }
+
+    const QImage::Format target = image.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32;
+    const bool inPlace = image.depth() == 32;
+    QImage result = inPlace ? QImage() : QImage(image.size(), target);
+    if (!inPlace && result.isNull()) return QImage(); // a second full-size image did not fit
+
+    const int width = image.width();
+    const int height = image.height();
+    const int rows = bandRows > 0 ? bandRows : std::max(1, (4 << 20) / (width * 4));
+    for (int y = 0; y < height; y += rows) {
+        const int bandHeight = std::min(rows, height - y);
+
+        // Non-owning view of the rows, converted into a band sized buffer
+        QImage view(image.constScanLine(y), width, bandHeight, image.bytesPerLine(), image.format());
+        if (image.colorCount() > 0) { // Indexed8, Mono and MonoLSB
+            view.setColorTable(image.colorTable());
+        }
+        QImage band = view.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        view = QImage();
+        if (band.isNull()) return QImage();
+
+        applyTint(band, settings);
+        band.convertTo(target);
+
+        QImage &out = inPlace ? image : result;
+        for (int row = 0; row < bandHeight; ++row) {
+            std::memcpy(out.scanLine(y + row), band.constScanLine(row), static_cast<std::size_t>(width) * 4);
+        }
+    }
+
+    if (!inPlace) return result;
+    image.reinterpretAsFormat(target);
+    return image;
+}
@@ -0,0 +1,127 @@
+#include "object_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compares the global heap against the pools for small allocations.
+// "Churn" keeps a working set of live blocks and repeatedly frees a random one and allocates a replacement,
+// which is the allocation pattern of short-lived small resources in a hot loop. Build with the release preset.
+namespace
+{
+    constexpr std::size_t kWorkingSet = 10'000;
+    constexpr std::size_t kOperations = 10'000'000;
+    constexpr std::size_t kBulkCount = 1'000'000;
+
+    struct HeapAllocator {
+        template <std::size_t Size>
+        static void* allocate() { return ::operator new(Size); }
+        template <std::size_t Size>
+        static void deallocate(void* ptr) { ::operator delete(ptr); }
+    };
+
+    struct PoolAllocator {
+        template <std::size_t Size>
+        static void* allocate() { return ThreadLocalPool<Size>::allocate(); }
+        template <std::size_t Size>
+        static void deallocate(void* ptr) { ThreadLocalPool<Size>::deallocate(ptr); }
+    };
+
+    template <typename Func>
+    double measureMilliseconds(Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    // Writes to every block so the allocator cannot hand out memory that is never touched.
+    template <typename Allocator, std::size_t Size>
+    void churn(std::size_t operations, std::uint32_t seed)
+    {
+        std::vector<void*> live(kWorkingSet);
+        for (void*& ptr : live) {
+            ptr = Allocator::template allocate<Size>();
+            *static_cast<std::uint32_t*>(ptr) = 1;
+        }
+
+        std::minstd_rand rng(seed);
+        for (std::size_t i = 0; i < operations; ++i) {
+            void*& slot = live[rng() % kWorkingSet];
+            Allocator::template deallocate<Size>(slot);
+            slot = Allocator::template allocate<Size>();
+            *static_cast<std::uint32_t*>(slot) = static_cast<std::uint32_t>(i);
+        }
+
+        for (void* ptr : live)
+            Allocator::template deallocate<Size>(ptr);
+    }
+
+    template <typename Allocator, std::size_t Size>
+    double churnOnThreads(unsigned threadCount)
+    {
+        return measureMilliseconds([&] {
+            std::vector<std::jthread> threads;
+            for (unsigned t = 0; t < threadCount; ++t)
+                threads.emplace_back([t, threadCount] { churn<Allocator, Size>(kOperations / threadCount, t + 1); });
+        });
+    }
+
+    void printRow(const std::string& name, double ms, std::size_t operations)
+    {
+        std::cout << std::format("{:<44} {:>10.2f} {:>12.2f}\n", name, ms, ms * 1'000'000.0 / operations);
+    }
+
+    template <std::size_t Size>
+    void runChurn(unsigned threadCount)
+    {
+        std::string suffix = std::format("{} B, {} thread{}", Size, threadCount, threadCount == 1 ? "" : "s");
+        printRow("churn global heap, " + suffix, churnOnThreads<HeapAllocator, Size>(threadCount), kOperations);
+        printRow("churn thread-local pool, " + suffix, churnOnThreads<PoolAllocator, Size>(threadCount), kOperations);
+    }
+
+    void runBulkRelease()
+    {
+        std::vector<void*> blocks(kBulkCount);
+
+        double heap = measureMilliseconds([&] {
+            for (void*& ptr : blocks)
+                ptr = ::operator new(sizeof(int));
+            for (void* ptr : blocks)
+                ::operator delete(ptr);
+        });
+        printRow("1M allocs + 1M frees, global heap", heap, kBulkCount);
+
+        FixedSizePool<sizeof(int), 4096> pool;
+        double pooled = measureMilliseconds([&] {
+            for (void*& ptr : blocks)
+                ptr = pool.allocate();
+            pool.release();
+        });
+        printRow("1M allocs + release(), pool", pooled, kBulkCount);
+    }
+}
+
+int main()
+{
+    // At least 4 threads, so the contended case is also measured on small machines.
+    const unsigned threadCount = std::max(4u, std::thread::hardware_concurrency());
+
+    std::cout << std::format("Allocator benchmark: working set {}, {} operations per row\n\n", kWorkingSet, kOperations);
+    std::cout << std::format("{:<44} {:>10} {:>12}\n", "scenario", "ms", "ns/op");
+    std::cout << std::string(68, '-') << '\n';
+
+    runChurn<sizeof(int)>(1);
+    runChurn<64>(1);
+    runChurn<sizeof(int)>(threadCount);
+    runChurn<64>(threadCount);
+    runBulkRelease();
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "object_pool.h"
+#include <iostream>
+#include <new> // for placement new
+#include <string>
+
+class Program_01_Object_Pool
+{
+public:
+    struct Particle {
+        float x, y, z;
+        float velocity;
+    };
+
+    void Run()
+    {
+        exercise_1_block_reuse();
+        exercise_2_slab_growth();
+        exercise_3_objects_in_blocks();
+        exercise_4_bulk_release();
+    }
+
+private:
+    // Question: What address does the pool return after a block was freed?
+    void exercise_1_block_reuse()
+    {
+        std::cout << "\n🚀 Exercise 1: Block Reuse\n";
+        FixedSizePool<sizeof(int)> pool;
+
+        void* a = pool.allocate();
+        void* b = pool.allocate();
+        std::cout << "a = " << a << ", b = " << b << " (" << FixedSizePool<sizeof(int)>::kBlockSize << " bytes apart)\n";
+
+        pool.deallocate(a);
+        void* c = pool.allocate();
+        std::cout << "After freeing a, the next block is " << c << (c == a ? " (the same block)" : "") << "\n";
+
+        pool.deallocate(b);
+        pool.deallocate(c);
+    }
+
+    // Question: How many trips to the global heap does it take to allocate 3000 blocks?
+    void exercise_2_slab_growth()
+    {
+        std::cout << "\n🚀 Exercise 2: Slab Growth\n";
+        FixedSizePool<sizeof(int), 1024> pool;
+        void* blocks[3000];
+        for (void*& block : blocks)
+            block = pool.allocate();
+
+        std::cout << "Blocks in use: " << pool.blocksInUse() << ", slabs: " << pool.slabCount()
+                  << ", capacity: " << pool.capacityInBytes() << " bytes\n";
+
+        for (void* block : blocks)
+            pool.deallocate(block);
+    }
+
+    // Question: How do you construct a real object in a pool block?
+    void exercise_3_objects_in_blocks()
+    {
+        std::cout << "\n🚀 Exercise 3: Objects in Pool Blocks\n";
+        FixedSizePool<sizeof(Particle)> pool;
+
+        // placement new constructs the object in memory we already own.
+        Particle* p = new (pool.allocate()) Particle{1.0f, 2.0f, 3.0f, 0.5f};
+        std::cout << "Particle at (" << p->x << ", " << p->y << ", " << p->z << ")\n";
+
+        // The destructor must be called by hand before the block goes back to the pool.
+        p->~Particle();
+        pool.deallocate(p);
+    }
+
+    // Question: How do you free thousands of blocks that all die at the same time?
+    void exercise_4_bulk_release()
+    {
+        std::cout << "\n🚀 Exercise 4: Bulk Release\n";
+        using Pool = ThreadLocalPool<sizeof(Particle)>;
+
+        for (int i = 0; i < 5000; ++i)
+            new (Pool::allocate()) Particle{0.0f, 0.0f, 0.0f, static_cast<float>(i)};
+
+        std::cout << "Before release: " << Pool::local().blocksInUse() << " blocks in " << Pool::local().slabCount() << " slabs\n";
+        // Particle is trivially destructible, so no destructor has to run: drop everything at once.
+        Pool::release();
+        std::cout << "After release:  " << Pool::local().blocksInUse() << " blocks in " << Pool::local().slabCount() << " slabs\n";
+    }
+};
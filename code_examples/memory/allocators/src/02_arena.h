@@ -0,0 +1,89 @@
+#include "arena.h"
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+class Program_02_Arena
+{
+public:
+    void Run()
+    {
+        exercise_1_bump_allocation();
+        exercise_2_alignment();
+        exercise_3_growing_blocks();
+        exercise_4_scoped_reset();
+        exercise_5_standard_containers();
+    }
+
+private:
+    // Question: Where does the next allocation end up?
+    void exercise_1_bump_allocation()
+    {
+        std::cout << "\n🚀 Exercise 1: Bump Allocation\n";
+        Arena arena;
+        auto* a = arena.create<int>(1);
+        auto* b = arena.create<int>(2);
+        auto* c = arena.create<int>(3);
+        // alignof(int) is 4, so the ints are packed right after each other.
+        std::cout << "a = " << a << ", b = " << b << ", c = " << c << "\n";
+    }
+
+    // Question: What happens when a char is followed by a double?
+    void exercise_2_alignment()
+    {
+        std::cout << "\n🚀 Exercise 2: Alignment\n";
+        Arena arena;
+        auto* ch = arena.create<char>('x');
+        auto* d = arena.create<double>(3.14);
+        // The arena skips bytes so the double starts at a multiple of alignof(double).
+        std::cout << "char at " << static_cast<void*>(ch) << ", double at " << d
+                  << " (" << reinterpret_cast<std::byte*>(d) - reinterpret_cast<std::byte*>(ch) << " bytes further)\n";
+    }
+
+    // Question: What does the arena do when its block is full?
+    void exercise_3_growing_blocks()
+    {
+        std::cout << "\n🚀 Exercise 3: Growing Blocks\n";
+        Arena arena(1024);
+        for (int i = 0; i < 1000; ++i)
+            arena.create<int>(i);
+        std::cout << "1000 ints: " << arena.blockCount() << " blocks, " << arena.capacity() << " bytes\n";
+
+        arena.reset();
+        for (int i = 0; i < 1000; ++i)
+            arena.create<int>(i);
+        std::cout << "After reset and 1000 more: " << arena.blockCount() << " blocks (the blocks are reused)\n";
+    }
+
+    // Question: How do you free everything a request allocated, without tracking each object?
+    void exercise_4_scoped_reset()
+    {
+        std::cout << "\n🚀 Exercise 4: Scoped Reset per Request\n";
+        Arena arena;
+        for (int request = 0; request < 3; ++request)
+        {
+            ScopedArenaReset scope(arena);
+
+            std::string_view text = "payload of a request";
+            char* copy = arena.allocateArray<char>(text.size() + 1);
+            std::memcpy(copy, text.data(), text.size());
+            copy[text.size()] = '\0';
+
+            std::cout << "Request " << request << ": '" << copy << "' at " << static_cast<void*>(copy) << "\n";
+            // scope ends: the arena rewinds, the next request gets the same memory
+        }
+    }
+
+    // Question: How can a std::vector use the arena?
+    void exercise_5_standard_containers()
+    {
+        std::cout << "\n🚀 Exercise 5: Standard Containers\n";
+        Arena arena;
+        std::vector<int, ArenaAllocator<int>> numbers{ArenaAllocator<int>(arena)};
+        for (int i = 0; i < 100; ++i)
+            numbers.push_back(i);
+        // Every reallocation of the vector took new memory from the arena, the old buffers are only freed by reset().
+        std::cout << "Vector of " << numbers.size() << " ints, arena capacity: " << arena.capacity() << " bytes\n";
+    }
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// A monotonic (bump-pointer) arena: allocating moves a pointer forward, freeing a single object does nothing.
+// All memory is given back at once with reset(), which is ideal for objects that all die together,
+// like everything allocated while handling one request.
+// The blocks are kept after a reset, so a steady workload stops touching the global heap altogether.
+// Not thread-safe. The standard library offers the same idea as std::pmr::monotonic_buffer_resource.
+class Arena
+{
+public:
+    // A position in the arena, see mark() and rewind().
+    struct Marker {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    explicit Arena(std::size_t initialBlockSize = 4096)
+        : m_nextBlockSize(std::max<std::size_t>(initialBlockSize, 64)) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        // try the current block, then the blocks that a previous reset left behind
+        while (m_current < m_blocks.size()) {
+            if (void* ptr = tryAllocate(m_blocks[m_current], bytes, alignment))
+                return ptr;
+            ++m_current;
+            m_offset = 0;
+        }
+
+        // no block fits: add a new one, each block is twice as large as the previous one
+        std::size_t size = std::max(m_nextBlockSize, bytes + alignment);
+        m_blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+        m_nextBlockSize = size * 2;
+        m_current = m_blocks.size() - 1;
+        m_offset = 0;
+        return tryAllocate(m_blocks[m_current], bytes, alignment);
+    }
+
+    // Constructs a T in the arena. Its destructor is never called by the arena,
+    // so T should be trivially destructible or the caller must destroy it by hand.
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T* allocateArray(std::size_t count)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    Marker mark() const { return {m_current, m_offset}; }
+
+    // Frees everything allocated after the marker was taken.
+    void rewind(Marker marker)
+    {
+        m_current = marker.block;
+        m_offset = marker.offset;
+    }
+
+    // Frees everything, but keeps the blocks for the next round.
+    void reset() { rewind({}); }
+
+    // Gives the blocks back to the global heap.
+    void release()
+    {
+        m_blocks.clear();
+        reset();
+    }
+
+    std::size_t blockCount() const { return m_blocks.size(); }
+
+    std::size_t capacity() const
+    {
+        std::size_t total = 0;
+        for (const Block& block : m_blocks)
+            total += block.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    void* tryAllocate(const Block& block, std::size_t bytes, std::size_t alignment)
+    {
+        // round the address (not the offset) up, blocks are only guaranteed to be aligned to max_align_t
+        auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        std::size_t newOffset = aligned - base + bytes;
+        if (newOffset > block.size)
+            return nullptr;
+        m_offset = newOffset;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    std::vector<Block> m_blocks;
+    std::size_t m_current = 0;
+    std::size_t m_offset = 0;
+    std::size_t m_nextBlockSize;
+};
+
+// RAII guard: everything allocated from the arena during its lifetime is freed when it goes out of scope.
+class ScopedArenaReset
+{
+public:
+    explicit ScopedArenaReset(Arena& arena) : m_arena(arena), m_marker(arena.mark()) {}
+    ~ScopedArenaReset() { m_arena.rewind(m_marker); }
+
+    ScopedArenaReset(const ScopedArenaReset&) = delete;
+    ScopedArenaReset& operator=(const ScopedArenaReset&) = delete;
+
+private:
+    Arena& m_arena;
+    Arena::Marker m_marker;
+};
+
+// Lets standard containers allocate from an arena, e.g. std::vector<int, ArenaAllocator<int>>.
+// deallocate() is a no-op: the memory comes back when the arena is reset.
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena) noexcept : m_arena(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+    T* allocate(std::size_t count) { return m_arena->allocateArray<T>(count); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    Arena* arena() const noexcept { return m_arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.arena(); }
+
+private:
+    Arena* m_arena;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// A pool of fixed-size blocks carved out of large slabs.
+// Freed blocks go onto an intrusive free list (the "next" pointer is stored inside the free block itself),
+// so allocate() and deallocate() are a couple of pointer operations instead of a trip through the global heap.
+// Not thread-safe: use one pool per thread, see ThreadLocalPool.
+template <std::size_t BlockSize, std::size_t BlocksPerSlab = 1024>
+class FixedSizePool
+{
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+public:
+    static constexpr std::size_t kAlignment = alignof(std::max_align_t);
+    // A block must be able to hold the free list pointer and keep every following block aligned.
+    static constexpr std::size_t kBlockSize =
+        (std::max(BlockSize, sizeof(FreeBlock)) + kAlignment - 1) / kAlignment * kAlignment;
+
+    FixedSizePool() = default;
+    ~FixedSizePool() = default;
+
+    FixedSizePool(const FixedSizePool&) = delete;
+    FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+    void* allocate()
+    {
+        // 1. reuse a freed block
+        if (m_freeList != nullptr) {
+            FreeBlock* block = m_freeList;
+            m_freeList = block->next;
+            ++m_blocksInUse;
+            return block;
+        }
+
+        // 2. carve the next untouched block from the current slab, start a new slab when it is full
+        if (m_bump == m_bumpEnd) {
+            addSlab();
+        }
+        std::byte* block = m_bump;
+        m_bump += kBlockSize;
+        ++m_blocksInUse;
+        return block;
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = m_freeList;
+        m_freeList = block;
+        --m_blocksInUse;
+    }
+
+    // Bulk release: frees every slab at once. All blocks handed out by this pool become invalid,
+    // no destructors are run, so only use it for trivially destructible contents or after destroying them.
+    void release() noexcept
+    {
+        m_slabs.clear();
+        m_freeList = nullptr;
+        m_bump = nullptr;
+        m_bumpEnd = nullptr;
+        m_blocksInUse = 0;
+    }
+
+    std::size_t blocksInUse() const { return m_blocksInUse; }
+    std::size_t slabCount() const { return m_slabs.size(); }
+    std::size_t capacityInBytes() const { return m_slabs.size() * BlocksPerSlab * kBlockSize; }
+
+private:
+    void addSlab()
+    {
+        // operator new[] returns memory aligned for any fundamental type, which is all kAlignment asks for.
+        m_slabs.push_back(std::make_unique_for_overwrite<std::byte[]>(BlocksPerSlab * kBlockSize));
+        m_bump = m_slabs.back().get();
+        m_bumpEnd = m_bump + BlocksPerSlab * kBlockSize;
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+    FreeBlock* m_freeList = nullptr;
+    std::byte* m_bump = nullptr;
+    std::byte* m_bumpEnd = nullptr;
+    std::size_t m_blocksInUse = 0;
+};
+
+// One FixedSizePool per thread, so allocations never take a lock or touch another core's cache lines.
+// A block must be freed on the thread that allocated it and must not outlive that thread.
+template <std::size_t BlockSize, std::size_t BlocksPerSlab = 1024>
+class ThreadLocalPool
+{
+public:
+    using Pool = FixedSizePool<BlockSize, BlocksPerSlab>;
+
+    static void* allocate() { return local().allocate(); }
+    static void deallocate(void* ptr) noexcept { local().deallocate(ptr); }
+
+    // Bulk release of the calling thread's pool.
+    static void release() noexcept { local().release(); }
+
+    static Pool& local()
+    {
+        thread_local Pool pool;
+        return pool;
+    }
+};
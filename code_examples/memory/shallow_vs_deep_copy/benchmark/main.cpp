@@ -0,0 +1,110 @@
+#include "arena.h"
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Simulates request handlers that build thousands of small deep-copied strings which all die at the end of the request.
+// Compares freeing every object with delete against resetting an arena once per request. Build with the release preset.
+namespace
+{
+    constexpr int kRequests = 2'000;
+    constexpr int kObjectsPerRequest = 5'000;
+
+    // Same layout as BetterString, without the logging.
+    struct HeapString {
+        char* m_data;
+        std::size_t m_size;
+
+        explicit HeapString(const char* initial_data) {
+            m_size = std::strlen(initial_data) + 1;
+            m_data = new char[m_size];
+            std::memcpy(m_data, initial_data, m_size);
+        }
+
+        ~HeapString() { delete[] m_data; }
+
+        HeapString(const HeapString&) = delete;
+        HeapString& operator=(const HeapString&) = delete;
+    };
+
+    // The object and its characters both live in the arena, nothing is freed individually.
+    struct ArenaString {
+        char* m_data;
+        std::size_t m_size;
+
+        ArenaString(Arena& arena, const char* initial_data) {
+            m_size = std::strlen(initial_data) + 1;
+            m_data = arena.allocateArray<char>(m_size);
+            std::memcpy(m_data, initial_data, m_size);
+        }
+    };
+
+    template <typename Func>
+    double measureMilliseconds(Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    void printRow(const std::string& name, double ms)
+    {
+        const double objects = static_cast<double>(kRequests) * kObjectsPerRequest;
+        std::cout << std::format("{:<36} {:>10.2f} {:>12.2f}\n", name, ms, ms * 1'000'000.0 / objects);
+    }
+}
+
+int main()
+{
+    // A mix of lengths: short ones fit a small-string buffer, long ones do not.
+    const std::vector<std::string> texts = {
+        "id", "user-name", "Content-Type: application/json", "a somewhat longer header value used by the request",
+    };
+
+    std::size_t checksum = 0;
+    std::vector<HeapString*> heapObjects;
+    heapObjects.reserve(kObjectsPerRequest);
+    std::vector<ArenaString*> arenaObjects;
+    arenaObjects.reserve(kObjectsPerRequest);
+
+    double heap = measureMilliseconds([&] {
+        for (int request = 0; request < kRequests; ++request)
+        {
+            for (int i = 0; i < kObjectsPerRequest; ++i)
+                heapObjects.push_back(new HeapString(texts[i % texts.size()].c_str()));
+            checksum += heapObjects.back()->m_size;
+
+            // end of request: every object is deleted one by one (2 frees each)
+            for (HeapString* object : heapObjects)
+                delete object;
+            heapObjects.clear();
+        }
+    });
+
+    Arena arena;
+    double arenaReset = measureMilliseconds([&] {
+        for (int request = 0; request < kRequests; ++request)
+        {
+            ScopedArenaReset scope(arena);
+            for (int i = 0; i < kObjectsPerRequest; ++i)
+                arenaObjects.push_back(arena.create<ArenaString>(arena, texts[i % texts.size()].c_str()));
+            checksum += arenaObjects.back()->m_size;
+
+            // end of request: ScopedArenaReset rewinds the arena, the pointers are simply forgotten
+            arenaObjects.clear();
+        }
+    });
+
+    std::cout << std::format("Arena benchmark: {} requests x {} strings\n\n", kRequests, kObjectsPerRequest);
+    std::cout << std::format("{:<36} {:>10} {:>12}\n", "scenario", "ms", "ns/object");
+    std::cout << std::string(60, '-') << '\n';
+    printRow("new + delete per object", heap);
+    printRow("arena + reset per request", arenaReset);
+    std::cout << std::format("\narena blocks: {}, capacity: {} bytes (checksum {})\n", arena.blockCount(), arena.capacity(), checksum);
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "slot_map.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compares three ways to store entities that refer to each other:
+// - SlotMap<T> with generational handles
+// - std::vector<std::shared_ptr<T>>, referenced through std::weak_ptr
+// - std::unordered_map<id, T>, referenced by id
+// Half of the entities are erased before iterating and looking up, so all three have to deal with holes.
+// Build with the release preset.
+namespace
+{
+    constexpr std::uint32_t kEntityCount = 1'000'000;
+    constexpr std::size_t kLookups = 10'000'000;
+    constexpr int kIterations = 20;
+
+    struct Entity {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        float vx = 1.0f, vy = 1.0f, vz = 1.0f;
+    };
+
+    template <typename Func>
+    double measureMilliseconds(Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    void printRow(const std::string& container, const std::string& operation, double ms, std::size_t operations)
+    {
+        std::cout << std::format("{:<28} {:<10} {:>10.2f} {:>10.2f}\n", container, operation, ms, ms * 1'000'000.0 / operations);
+    }
+
+    void update(Entity& e)
+    {
+        e.x += e.vx;
+        e.y += e.vy;
+        e.z += e.vz;
+    }
+
+    // Lookups are uniformly random, so about half of them hit an erased entity and measure the stale path as well.
+    std::vector<std::uint32_t> makeLookupOrder()
+    {
+        std::vector<std::uint32_t> order(kLookups);
+        std::minstd_rand rng(7);
+        for (std::uint32_t& index : order)
+            index = rng() % kEntityCount;
+        return order;
+    }
+
+    std::vector<std::uint32_t> makeEraseOrder()
+    {
+        std::vector<std::uint32_t> order(kEntityCount);
+        for (std::uint32_t i = 0; i < kEntityCount; ++i)
+            order[i] = i;
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        order.resize(kEntityCount / 2);
+        return order;
+    }
+
+    void benchmarkSlotMap(const std::vector<std::uint32_t>& eraseOrder, const std::vector<std::uint32_t>& lookupOrder)
+    {
+        SlotMap<Entity> entities;
+        std::vector<SlotMap<Entity>::Handle> handles(kEntityCount);
+
+        double insert = measureMilliseconds([&] {
+            for (std::uint32_t i = 0; i < kEntityCount; ++i)
+                handles[i] = entities.insert({});
+        });
+        double erase = measureMilliseconds([&] {
+            for (std::uint32_t i : eraseOrder)
+                entities.erase(handles[i]);
+        });
+        double iterate = measureMilliseconds([&] {
+            for (int it = 0; it < kIterations; ++it)
+                for (Entity& e : entities)
+                    update(e);
+        });
+        std::size_t found = 0;
+        double lookup = measureMilliseconds([&] {
+            for (std::uint32_t i : lookupOrder)
+                if (Entity* e = entities.get(handles[i])) {
+                    update(*e);
+                    ++found;
+                }
+        });
+
+        printRow("SlotMap", "insert", insert, kEntityCount);
+        printRow("SlotMap", "erase", erase, eraseOrder.size());
+        printRow("SlotMap", "iterate", iterate, entities.size() * kIterations);
+        printRow("SlotMap", "lookup", lookup, lookupOrder.size());
+        std::cout << std::format("  ({} of {} lookups hit)\n", found, lookupOrder.size());
+    }
+
+    void benchmarkSharedPtr(const std::vector<std::uint32_t>& eraseOrder, const std::vector<std::uint32_t>& lookupOrder)
+    {
+        std::vector<std::shared_ptr<Entity>> entities;
+        std::vector<std::weak_ptr<Entity>> handles(kEntityCount);
+
+        double insert = measureMilliseconds([&] {
+            for (std::uint32_t i = 0; i < kEntityCount; ++i) {
+                entities.push_back(std::make_shared<Entity>());
+                handles[i] = entities.back();
+            }
+        });
+        // To keep erase O(1) the vector does the same swap and pop as the slot map, but it has to find the element first
+        // through a side table of positions.
+        std::vector<std::uint32_t> position(kEntityCount);
+        std::vector<std::uint32_t> owner(kEntityCount);
+        for (std::uint32_t i = 0; i < kEntityCount; ++i)
+            position[i] = owner[i] = i;
+        double erase = measureMilliseconds([&] {
+            for (std::uint32_t i : eraseOrder) {
+                std::uint32_t hole = position[i];
+                std::uint32_t last = static_cast<std::uint32_t>(entities.size() - 1);
+                entities[hole] = std::move(entities[last]);
+                owner[hole] = owner[last];
+                position[owner[hole]] = hole;
+                entities.pop_back();
+            }
+        });
+        double iterate = measureMilliseconds([&] {
+            for (int it = 0; it < kIterations; ++it)
+                for (const std::shared_ptr<Entity>& e : entities)
+                    update(*e);
+        });
+        std::size_t found = 0;
+        double lookup = measureMilliseconds([&] {
+            for (std::uint32_t i : lookupOrder)
+                if (std::shared_ptr<Entity> e = handles[i].lock()) {
+                    update(*e);
+                    ++found;
+                }
+        });
+
+        printRow("vector<shared_ptr> + weak", "insert", insert, kEntityCount);
+        printRow("vector<shared_ptr> + weak", "erase", erase, eraseOrder.size());
+        printRow("vector<shared_ptr> + weak", "iterate", iterate, entities.size() * kIterations);
+        printRow("vector<shared_ptr> + weak", "lookup", lookup, lookupOrder.size());
+        std::cout << std::format("  ({} of {} lookups hit)\n", found, lookupOrder.size());
+    }
+
+    void benchmarkUnorderedMap(const std::vector<std::uint32_t>& eraseOrder, const std::vector<std::uint32_t>& lookupOrder)
+    {
+        std::unordered_map<std::uint32_t, Entity> entities;
+
+        double insert = measureMilliseconds([&] {
+            for (std::uint32_t i = 0; i < kEntityCount; ++i)
+                entities.emplace(i, Entity{});
+        });
+        double erase = measureMilliseconds([&] {
+            for (std::uint32_t i : eraseOrder)
+                entities.erase(i);
+        });
+        double iterate = measureMilliseconds([&] {
+            for (int it = 0; it < kIterations; ++it)
+                for (auto& [id, e] : entities)
+                    update(e);
+        });
+        std::size_t found = 0;
+        double lookup = measureMilliseconds([&] {
+            for (std::uint32_t i : lookupOrder)
+                if (auto it = entities.find(i); it != entities.end()) {
+                    update(it->second);
+                    ++found;
+                }
+        });
+
+        printRow("unordered_map<id, T>", "insert", insert, kEntityCount);
+        printRow("unordered_map<id, T>", "erase", erase, eraseOrder.size());
+        printRow("unordered_map<id, T>", "iterate", iterate, entities.size() * kIterations);
+        printRow("unordered_map<id, T>", "lookup", lookup, lookupOrder.size());
+        std::cout << std::format("  ({} of {} lookups hit)\n", found, lookupOrder.size());
+    }
+}
+
+int main()
+{
+    const std::vector<std::uint32_t> eraseOrder = makeEraseOrder();
+    const std::vector<std::uint32_t> lookupOrder = makeLookupOrder();
+
+    std::cout << std::format("Slot map benchmark: {} entities, {} erased, {} lookups\n\n", kEntityCount, eraseOrder.size(), kLookups);
+    std::cout << std::format("{:<28} {:<10} {:>10} {:>10}\n", "container", "operation", "ms", "ns/op");
+    std::cout << std::string(61, '-') << '\n';
+
+    benchmarkSlotMap(eraseOrder, lookupOrder);
+    benchmarkSharedPtr(eraseOrder, lookupOrder);
+    benchmarkUnorderedMap(eraseOrder, lookupOrder);
+
+    return 0;
+}
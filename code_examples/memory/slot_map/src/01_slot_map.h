@@ -0,0 +1,94 @@
+#include "slot_map.h"
+#include <iostream>
+#include <string>
+
+class Program_01_Slot_Map
+{
+public:
+    struct Entity {
+        std::string name;
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    void Run()
+    {
+        exercise_1_handles_instead_of_pointers();
+        exercise_2_stale_handles();
+        exercise_3_dense_iteration();
+        exercise_4_entity_references();
+    }
+
+private:
+    // Question: What do you get back when you insert into a slot map?
+    void exercise_1_handles_instead_of_pointers()
+    {
+        std::cout << "\n🚀 Exercise 1: Handles Instead of Pointers\n";
+        SlotMap<Entity> entities;
+        auto player = entities.insert({"player", 1.0f, 2.0f});
+        auto enemy = entities.insert({"enemy", 5.0f, 5.0f});
+
+        std::cout << "player handle: index " << player.index << ", generation " << player.generation << "\n";
+        std::cout << "enemy handle:  index " << enemy.index << ", generation " << enemy.generation << "\n";
+        std::cout << "Lookup of the enemy: " << entities.get(enemy)->name << "\n";
+    }
+
+    // Question: What happens when you use a handle to an erased value, even after its slot was reused?
+    void exercise_2_stale_handles()
+    {
+        std::cout << "\n🚀 Exercise 2: Stale Handles\n";
+        SlotMap<Entity> entities;
+        auto bullet = entities.insert({"bullet"});
+        entities.erase(bullet);
+
+        // The new value reuses the same slot, but with the next generation.
+        auto rocket = entities.insert({"rocket"});
+        std::cout << "bullet: index " << bullet.index << ", generation " << bullet.generation << "\n";
+        std::cout << "rocket: index " << rocket.index << ", generation " << rocket.generation << "\n";
+
+        // With a raw pointer this would silently point at the rocket. The handle knows it is stale.
+        const Entity* stale = entities.get(bullet);
+        std::cout << "Lookup with the old bullet handle: " << (stale ? stale->name : "nullptr (stale)") << "\n";
+        std::cout << "Erasing it again: " << std::boolalpha << entities.erase(bullet) << "\n";
+    }
+
+    // Question: Why is iterating a slot map as fast as iterating a vector?
+    void exercise_3_dense_iteration()
+    {
+        std::cout << "\n🚀 Exercise 3: Dense Iteration\n";
+        SlotMap<Entity> entities;
+        auto a = entities.insert({"a"});
+        entities.insert({"b"});
+        entities.insert({"c"});
+        entities.insert({"d"});
+
+        // Erasing "a" moves the last value ("d") into its place, the values stay contiguous.
+        entities.erase(a);
+        std::cout << "Values in memory order: ";
+        for (const Entity& entity : entities)
+            std::cout << entity.name << " ";
+        std::cout << "\n";
+    }
+
+    // Question: How do entities refer to each other without pointers or shared_ptr?
+    void exercise_4_entity_references()
+    {
+        std::cout << "\n🚀 Exercise 4: Entity References\n";
+        struct Missile {
+            SlotMap<Entity>::Handle target;
+        };
+
+        SlotMap<Entity> entities;
+        auto ship = entities.insert({"ship", 10.0f, 0.0f});
+        Missile missile{ship};
+
+        entities.erase(ship);
+        entities.insert({"asteroid"}); // reuses the slot of the ship
+
+        // A missile holding an Entity* would now chase the asteroid.
+        if (const Entity* target = entities.get(missile.target))
+            std::cout << "Missile tracks " << target->name << "\n";
+        else
+            std::cout << "Missile target is gone, the missile self-destructs\n";
+    }
+};
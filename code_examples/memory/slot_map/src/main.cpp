@@ -0,0 +1,22 @@
+#include "01_slot_map.h"
+#include <format>
+
+int main(int argc, char* argv[])
+{
+    int programId = 1;
+
+    if (argc > 1)
+        programId = std::atoi(argv[1]);
+
+    std::cout << std::format("Running program {}...", programId) << std::endl;
+
+    switch (programId)
+    {
+        case 1:
+            Program_01_Slot_Map program1;
+            program1.Run();
+            break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// A slot map stores values densely in one vector and hands out handles instead of pointers.
+// A handle is an index into a table of slots plus a generation counter. Erasing a value bumps the
+// generation of its slot, so old handles to it are detected as stale instead of dangling.
+// insert, erase and lookup are O(1), iterating walks one contiguous array.
+// Erasing moves the last value into the hole, so the order of the values is not stable.
+template <typename T>
+class SlotMap
+{
+    static constexpr std::uint32_t kInvalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    struct Handle {
+        std::uint32_t index = kInvalidIndex;
+        std::uint32_t generation = 0;
+
+        bool operator==(const Handle&) const = default;
+    };
+
+    template <typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        // make room in the index vectors first: once the value is constructed nothing below can
+        // throw, so an exception leaves the map untouched
+        reserveOneMore(m_valueToSlot);
+        if (m_freeHead == kInvalidIndex)
+            reserveOneMore(m_slots);
+        m_values.emplace_back(std::forward<Args>(args)...);
+
+        std::uint32_t slotIndex;
+        if (m_freeHead != kInvalidIndex) {
+            // reuse a slot, the free list is threaded through Slot::target
+            slotIndex = m_freeHead;
+            m_freeHead = m_slots[slotIndex].target;
+        } else {
+            slotIndex = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back({});
+        }
+
+        m_valueToSlot.push_back(slotIndex);
+
+        Slot& slot = m_slots[slotIndex];
+        slot.target = static_cast<std::uint32_t>(m_values.size() - 1);
+        return {slotIndex, slot.generation};
+    }
+
+    Handle insert(const T& value) { return emplace(value); }
+    Handle insert(T&& value) { return emplace(std::move(value)); }
+
+    // Returns false when the handle was already stale.
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        Slot& slot = m_slots[handle.index];
+        std::uint32_t hole = slot.target;
+        std::uint32_t last = static_cast<std::uint32_t>(m_values.size() - 1);
+
+        // swap and pop: keep the values dense, fix up the slot of the value that moved
+        if (hole != last) {
+            m_values[hole] = std::move(m_values[last]);
+            m_valueToSlot[hole] = m_valueToSlot[last];
+            m_slots[m_valueToSlot[hole]].target = hole;
+        }
+        m_values.pop_back();
+        m_valueToSlot.pop_back();
+
+        // invalidate every outstanding handle to this slot and put it on the free list
+        ++slot.generation;
+        slot.target = m_freeHead;
+        m_freeHead = handle.index;
+        return true;
+    }
+
+    bool contains(Handle handle) const
+    {
+        return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+    }
+
+    // Returns nullptr for a stale handle.
+    T* get(Handle handle) { return contains(handle) ? &m_values[m_slots[handle.index].target] : nullptr; }
+    const T* get(Handle handle) const { return contains(handle) ? &m_values[m_slots[handle.index].target] : nullptr; }
+
+    void reserve(std::size_t capacity)
+    {
+        m_values.reserve(capacity);
+        m_valueToSlot.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    // Erases every value. The slots are kept with a bumped generation, so no old handle becomes valid again.
+    void clear()
+    {
+        for (std::uint32_t valueIndex = 0; valueIndex < m_valueToSlot.size(); ++valueIndex) {
+            std::uint32_t slotIndex = m_valueToSlot[valueIndex];
+            ++m_slots[slotIndex].generation;
+            m_slots[slotIndex].target = m_freeHead;
+            m_freeHead = slotIndex;
+        }
+        m_values.clear();
+        m_valueToSlot.clear();
+    }
+
+    std::size_t size() const { return m_values.size(); }
+    bool empty() const { return m_values.empty(); }
+
+    // Iteration goes over the dense values, not over the handles.
+    auto begin() { return m_values.begin(); }
+    auto end() { return m_values.end(); }
+    auto begin() const { return m_values.begin(); }
+    auto end() const { return m_values.end(); }
+
+private:
+    struct Slot {
+        std::uint32_t target = kInvalidIndex; // index into m_values when used, next free slot when free
+        std::uint32_t generation = 0;
+    };
+
+    // Grows geometrically like push_back would, reserve(size() + 1) alone would reallocate every time.
+    template <typename U>
+    static void reserveOneMore(std::vector<U>& vector)
+    {
+        if (vector.size() == vector.capacity())
+            vector.reserve(vector.empty() ? 8 : vector.size() * 2);
+    }
+
+    std::vector<T> m_values;
+    std::vector<std::uint32_t> m_valueToSlot;
+    std::vector<Slot> m_slots;
+    std::uint32_t m_freeHead = kInvalidIndex;
+};
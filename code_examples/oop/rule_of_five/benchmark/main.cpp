@@ -0,0 +1,188 @@
+#include "object_pool.h"
+#include "tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <format>
+#include <iostream>
+#include <list>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Runs every container scenario a few times and prints the average time next to the
+// copies, moves and allocations that one run costs. Build with the release preset.
+namespace
+{
+    constexpr int kElementCount = 100'000;
+    constexpr int kRepetitions = 5;
+
+    // Tracer resources from the thread-local pool of the allocators example instead of the global heap.
+    struct PooledResource {
+        using Pool = ThreadLocalPool<sizeof(int)>;
+        static int* allocate(int value) { return new (Pool::allocate()) int(value); }
+        static void deallocate(int* res) { Pool::deallocate(res); }
+    };
+    using PooledTracer = BasicTracer<true, PooledResource>;
+
+    struct Result
+    {
+        double milliseconds = 0.0;
+        instrumentation::Counters counters;
+    };
+
+    template <typename Func>
+    Result measure(Func&& func)
+    {
+        Result result;
+        for (int i = 0; i < kRepetitions; ++i)
+        {
+            instrumentation::ScopedCounters counters;
+            auto start = std::chrono::steady_clock::now();
+            func();
+            auto stop = std::chrono::steady_clock::now();
+
+            result.milliseconds += std::chrono::duration<double, std::milli>(stop - start).count();
+            result.counters = counters.delta();
+        }
+        result.milliseconds /= kRepetitions;
+        return result;
+    }
+
+    void printHeader()
+    {
+        std::cout << std::format("{:<40} {:>10} {:>10} {:>10} {:>10} {:>12}\n",
+                                 "scenario", "ms", "copies", "moves", "allocs", "heap bytes");
+        std::cout << std::string(97, '-') << '\n';
+    }
+
+    void printRow(const std::string& name, const Result& r)
+    {
+        std::cout << std::format("{:<40} {:>10.3f} {:>10} {:>10} {:>10} {:>12}\n",
+                                 name, r.milliseconds, r.counters.copies(), r.counters.moves(),
+                                 r.counters.allocations, r.counters.bytesAllocated);
+    }
+
+    template <typename Func>
+    void run(const std::string& name, Func&& func)
+    {
+        printRow(name, measure(std::forward<Func>(func)));
+    }
+
+    std::vector<std::string> makeNames()
+    {
+        std::vector<std::string> names;
+        names.reserve(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+            names.push_back("t" + std::to_string(i));
+        return names;
+    }
+
+    std::vector<int> makeShuffledValues()
+    {
+        std::vector<int> values(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+            values[i] = i;
+        std::shuffle(values.begin(), values.end(), std::mt19937(42));
+        return values;
+    }
+}
+
+int main()
+{
+    instrumentation::ScopedQuiet quiet;
+    const std::vector<std::string> names = makeNames();
+    const std::vector<int> values = makeShuffledValues();
+
+    std::cout << std::format("Container benchmark: {} elements, average of {} runs\n\n", kElementCount, kRepetitions);
+    printHeader();
+
+    // push_back constructs a temporary and moves it in, emplace_back constructs in place.
+    run("vector push_back(Tracer(...))", [&] {
+        std::vector<Tracer> vec;
+        for (int i = 0; i < kElementCount; ++i)
+            vec.push_back(Tracer(names[i], values[i]));
+    });
+    run("vector emplace_back(...)", [&] {
+        std::vector<Tracer> vec;
+        for (int i = 0; i < kElementCount; ++i)
+            vec.emplace_back(names[i], values[i]);
+    });
+
+    // reserve() removes every relocation caused by growth.
+    run("vector reserve + emplace_back", [&] {
+        std::vector<Tracer> vec;
+        vec.reserve(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+            vec.emplace_back(names[i], values[i]);
+    });
+
+    // Same element count and allocation count, but every resource comes from a pool block.
+    run("vector reserve + emplace_back, pooled", [&] {
+        std::vector<PooledTracer> vec;
+        vec.reserve(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+            vec.emplace_back(names[i], values[i]);
+    });
+
+    // Without a noexcept move constructor the vector copies on reallocation (strong exception guarantee).
+    // Compare with the "vector emplace_back(...)" row above.
+    run("vector emplace_back, throwing move", [&] {
+        std::vector<ThrowingMoveTracer> vec;
+        for (int i = 0; i < kElementCount; ++i)
+            vec.emplace_back(names[i], values[i]);
+    });
+
+    // Node and block based containers never relocate their elements.
+    run("deque emplace_back", [&] {
+        std::deque<Tracer> deq;
+        for (int i = 0; i < kElementCount; ++i)
+            deq.emplace_back(names[i], values[i]);
+    });
+    run("list emplace_back", [&] {
+        std::list<Tracer> lst;
+        for (int i = 0; i < kElementCount; ++i)
+            lst.emplace_back(names[i], values[i]);
+    });
+
+    // map: insert() of a pair moves the Tracer into the node, try_emplace() constructs it there.
+    run("map insert(pair)", [&] {
+        std::map<int, Tracer> map;
+        for (int i = 0; i < kElementCount; ++i)
+            map.insert({values[i], Tracer(names[i], values[i])});
+    });
+    run("map try_emplace", [&] {
+        std::map<int, Tracer> map;
+        for (int i = 0; i < kElementCount; ++i)
+            map.try_emplace(values[i], names[i], values[i]);
+    });
+
+    // Sorting only moves elements around, the filling of the vector is not part of the counters.
+    {
+        std::vector<Tracer> unsorted;
+        unsorted.reserve(kElementCount);
+        for (int i = 0; i < kElementCount; ++i)
+            unsorted.emplace_back(names[i], values[i]);
+
+        std::vector<Tracer> vec;
+        vec.reserve(kElementCount);
+        Result r;
+        for (int i = 0; i < kRepetitions; ++i)
+        {
+            vec.assign(unsorted.begin(), unsorted.end());
+            instrumentation::ScopedCounters counters;
+            auto start = std::chrono::steady_clock::now();
+            std::sort(vec.begin(), vec.end());
+            auto stop = std::chrono::steady_clock::now();
+            r.milliseconds += std::chrono::duration<double, std::milli>(stop - start).count();
+            r.counters = counters.delta();
+        }
+        r.milliseconds /= kRepetitions;
+        printRow("vector sort", r);
+    }
+
+    return 0;
+}
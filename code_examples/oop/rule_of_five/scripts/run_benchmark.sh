@@ -0,0 +1,21 @@
+#!/bin/bash
+
+# setup stderr
+set -e
+
+# variables
+SCRIPT_DIR=$(dirname $0)
+PROJECT_DIR=$SCRIPT_DIR/..
+
+# go in project directory
+cd $PROJECT_DIR
+
+# configure (benchmarks are only meaningful in release)
+cmake --preset linux-clang-release
+
+# build
+cmake --build --preset linux-clang-release
+
+# execute
+echo -e "🚀 Benchmarking..."
+./build/linux-clang-release/MyBenchmark
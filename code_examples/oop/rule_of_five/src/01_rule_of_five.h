@@ -1,75 +1,9 @@
+#include "tracer.h"
 #include <iostream>
 #include <string>
 #include <utility> // for std::move
 #include <vector>
 
-struct Tracer {
-    std::string name;
-    int* resource; // simple pointer resource for demo purposes
-
-    // Constructor
-    Tracer(std::string n) : name(std::move(n)), resource(new int(42)) {
-        std::cout << "  " << name << ": Constructor\n";
-    }
-
-    // Desctructor
-    ~Tracer() {
-        std::cout << "  " << name << ": Destructor\n";
-        delete resource;
-    }
-
-    // Copy Constructor
-    Tracer(const Tracer& other)
-        : name(other.name), resource(new int(*other.resource))
-    {
-        std::cout << "  " << name << ": COPY Constructor from " << other.name << '\n';
-    }
-
-    // Copy Assignment Operator
-    Tracer& operator=(const Tracer& other) {
-        if (this == &other) 
-            return *this;
-        std::cout << "  " << name << ": COPY Assignment from " << other.name << '\n';
-        int* new_res = new int(*other.resource);  // allocate first
-        delete resource;
-        resource = new_res;
-        name = other.name;
-        return *this;
-    }
-
-    // Move Constructor
-    Tracer(Tracer&& other) noexcept
-    {
-        // capture the original name of the source object before moving its contents.
-        std::string original_other_name = other.name;
-
-        // move data
-        this->name = std::move(other.name);
-        this->resource = other.resource;
-
-        // print
-        std::cout << "  " << this->name << ": MOVE Constructor from " << original_other_name << '\n';
-        
-        // nullify the source object's resource pointer and modify its name for tracking its state.
-        other.resource = nullptr;
-        other.name += original_other_name + " [moved]"; 
-    }
-
-    // Move Assignment Operator
-    Tracer& operator=(Tracer&& other) noexcept {
-        if (this == &other) 
-            return *this;
-        std::string original_other_name = other.name;
-        std::cout << "  " << name << ": MOVE Assignment from " << other.name << '\n';
-        delete resource;
-        resource = other.resource;
-        name = other.name;
-        other.resource = nullptr;
-        other.name += original_other_name + " [moved]";
-        return *this;
-    }
-};
-
 // A helper function that creates and returns a Tracer object
 Tracer createTracer(const std::string& name) {
     return Tracer(name);
@@ -95,6 +29,7 @@ public:
         exercise_4_1();
         exercise_5_1();
         exercise_6_1();
+        exercise_7_1();
     }
 
 private:
@@ -201,4 +136,20 @@ private:
 
         std::cout << "Size of vector: " << vec.size() << ", capacity of vector: " << vec.capacity() << std::endl;
     }
+
+    // Question: How many copies, moves and resource allocations does it cost to grow a vector to 5 elements without reserve()?
+    // Count them instead of reading the log.
+    void exercise_7_1() {
+        std::cout << "\n🚀 Exercise 7.1\n";
+        instrumentation::ScopedQuiet quiet;
+        instrumentation::ScopedReport report("vector growth");
+
+        std::vector<Tracer> vec;
+        for (int i = 0; i < 5; ++i)
+            vec.emplace_back("v" + std::to_string(i));
+
+        const instrumentation::Counters counters = report.delta();
+        std::cout << "Copies: " << counters.copies() << ", moves: " << counters.moves()
+                  << ", capacity of vector: " << vec.capacity() << '\n';
+    }
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+
+// Counters for the special member functions and heap traffic of instrumented types.
+// Every instrumented event is recorded in one process-wide set of counters.
+// A ScopedCounters takes a snapshot when it is created, so it only reports what happened inside its scope.
+namespace instrumentation
+{
+    struct Counters
+    {
+        std::size_t constructions = 0;
+        std::size_t copyConstructions = 0;
+        std::size_t moveConstructions = 0;
+        std::size_t copyAssignments = 0;
+        std::size_t moveAssignments = 0;
+        std::size_t destructions = 0;
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t bytesAllocated = 0;
+        std::size_t bytesFreed = 0;
+
+        std::size_t copies() const { return copyConstructions + copyAssignments; }
+        std::size_t moves() const { return moveConstructions + moveAssignments; }
+
+        Counters operator-(const Counters& other) const
+        {
+            Counters result;
+            result.constructions = constructions - other.constructions;
+            result.copyConstructions = copyConstructions - other.copyConstructions;
+            result.moveConstructions = moveConstructions - other.moveConstructions;
+            result.copyAssignments = copyAssignments - other.copyAssignments;
+            result.moveAssignments = moveAssignments - other.moveAssignments;
+            result.destructions = destructions - other.destructions;
+            result.allocations = allocations - other.allocations;
+            result.deallocations = deallocations - other.deallocations;
+            result.bytesAllocated = bytesAllocated - other.bytesAllocated;
+            result.bytesFreed = bytesFreed - other.bytesFreed;
+            return result;
+        }
+    };
+
+    inline std::ostream& operator<<(std::ostream& os, const Counters& c)
+    {
+        os << "ctor=" << c.constructions
+           << " copy-ctor=" << c.copyConstructions
+           << " move-ctor=" << c.moveConstructions
+           << " copy-assign=" << c.copyAssignments
+           << " move-assign=" << c.moveAssignments
+           << " dtor=" << c.destructions
+           << " allocs=" << c.allocations
+           << " frees=" << c.deallocations
+           << " heap-bytes=" << c.bytesAllocated;
+        return os;
+    }
+
+    // The live counters. Relaxed atomics keep the counts exact when instrumented objects are used from several threads.
+    struct GlobalCounters
+    {
+        std::atomic<std::size_t> constructions{0};
+        std::atomic<std::size_t> copyConstructions{0};
+        std::atomic<std::size_t> moveConstructions{0};
+        std::atomic<std::size_t> copyAssignments{0};
+        std::atomic<std::size_t> moveAssignments{0};
+        std::atomic<std::size_t> destructions{0};
+        std::atomic<std::size_t> allocations{0};
+        std::atomic<std::size_t> deallocations{0};
+        std::atomic<std::size_t> bytesAllocated{0};
+        std::atomic<std::size_t> bytesFreed{0};
+        std::atomic<bool> verbose{true};
+    };
+
+    inline GlobalCounters& global()
+    {
+        static GlobalCounters counters;
+        return counters;
+    }
+
+    inline void increment(std::atomic<std::size_t>& counter, std::size_t amount = 1)
+    {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    inline void recordConstruction() { increment(global().constructions); }
+    inline void recordCopyConstruction() { increment(global().copyConstructions); }
+    inline void recordMoveConstruction() { increment(global().moveConstructions); }
+    inline void recordCopyAssignment() { increment(global().copyAssignments); }
+    inline void recordMoveAssignment() { increment(global().moveAssignments); }
+    inline void recordDestruction() { increment(global().destructions); }
+
+    inline void recordAllocation(std::size_t bytes)
+    {
+        increment(global().allocations);
+        increment(global().bytesAllocated, bytes);
+    }
+
+    inline void recordDeallocation(std::size_t bytes)
+    {
+        increment(global().deallocations);
+        increment(global().bytesFreed, bytes);
+    }
+
+    inline Counters snapshot()
+    {
+        const GlobalCounters& g = global();
+        Counters c;
+        c.constructions = g.constructions.load(std::memory_order_relaxed);
+        c.copyConstructions = g.copyConstructions.load(std::memory_order_relaxed);
+        c.moveConstructions = g.moveConstructions.load(std::memory_order_relaxed);
+        c.copyAssignments = g.copyAssignments.load(std::memory_order_relaxed);
+        c.moveAssignments = g.moveAssignments.load(std::memory_order_relaxed);
+        c.destructions = g.destructions.load(std::memory_order_relaxed);
+        c.allocations = g.allocations.load(std::memory_order_relaxed);
+        c.deallocations = g.deallocations.load(std::memory_order_relaxed);
+        c.bytesAllocated = g.bytesAllocated.load(std::memory_order_relaxed);
+        c.bytesFreed = g.bytesFreed.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    // Instrumented types print every special member call while this is on.
+    inline bool verbose() { return global().verbose.load(std::memory_order_relaxed); }
+    inline void setVerbose(bool enabled) { global().verbose.store(enabled, std::memory_order_relaxed); }
+
+    // Counts everything that happens between its construction and delta().
+    class ScopedCounters
+    {
+    public:
+        ScopedCounters() : m_start(snapshot()) {}
+
+        Counters delta() const { return snapshot() - m_start; }
+        void reset() { m_start = snapshot(); }
+
+    private:
+        Counters m_start;
+    };
+
+    // Prints the counters of its scope when it is destroyed.
+    class ScopedReport
+    {
+    public:
+        explicit ScopedReport(std::string label, std::ostream& os = std::cout)
+            : m_label(std::move(label)), m_os(os) {}
+
+        ~ScopedReport()
+        {
+            m_os << "[" << m_label << "] " << m_counters.delta() << '\n';
+        }
+
+        ScopedReport(const ScopedReport&) = delete;
+        ScopedReport& operator=(const ScopedReport&) = delete;
+
+        Counters delta() const { return m_counters.delta(); }
+
+    private:
+        std::string m_label;
+        std::ostream& m_os;
+        ScopedCounters m_counters;
+    };
+
+    // Silences the per-call printing of instrumented types, e.g. inside benchmark loops.
+    class ScopedQuiet
+    {
+    public:
+        ScopedQuiet() : m_previous(verbose()) { setVerbose(false); }
+        ~ScopedQuiet() { setVerbose(m_previous); }
+
+        ScopedQuiet(const ScopedQuiet&) = delete;
+        ScopedQuiet& operator=(const ScopedQuiet&) = delete;
+
+    private:
+        bool m_previous;
+    };
+}
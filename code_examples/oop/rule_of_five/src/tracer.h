@@ -0,0 +1,121 @@
+#pragma once
+
+#include "instrumentation.h"
+#include <iostream>
+#include <string>
+#include <utility> // for std::move
+
+// Where a tracer gets its resource from. The default is the global heap,
+// any type with the same two static functions can replace it (e.g. a pool allocator).
+struct HeapResource {
+    static int* allocate(int value) { return new int(value); }
+    static void deallocate(int* res) { delete res; }
+};
+
+// NoexceptMove = false gives the same type with a potentially throwing move constructor,
+// which std::vector refuses to use when it reallocates.
+template <bool NoexceptMove, typename Resource = HeapResource>
+struct BasicTracer {
+    std::string name;
+    int* resource; // simple pointer resource for demo purposes
+
+    // Constructor
+    BasicTracer(std::string n, int value = 42) : name(std::move(n)), resource(allocateResource(value)) {
+        instrumentation::recordConstruction();
+        log(": Constructor");
+    }
+
+    // Desctructor
+    ~BasicTracer() {
+        instrumentation::recordDestruction();
+        log(": Destructor");
+        releaseResource(resource);
+    }
+
+    // Copy Constructor
+    BasicTracer(const BasicTracer& other)
+        : name(other.name), resource(allocateResource(*other.resource))
+    {
+        instrumentation::recordCopyConstruction();
+        log(": COPY Constructor from ", other.name);
+    }
+
+    // Copy Assignment Operator
+    BasicTracer& operator=(const BasicTracer& other) {
+        if (this == &other)
+            return *this;
+        instrumentation::recordCopyAssignment();
+        log(": COPY Assignment from ", other.name);
+        int* new_res = allocateResource(*other.resource);  // allocate first
+        releaseResource(resource);
+        resource = new_res;
+        name = other.name;
+        return *this;
+    }
+
+    // Move Constructor
+    BasicTracer(BasicTracer&& other) noexcept(NoexceptMove)
+    {
+        // capture the original name of the source object before moving its contents.
+        std::string original_other_name = other.name;
+
+        // move data
+        this->name = std::move(other.name);
+        this->resource = other.resource;
+
+        // print
+        instrumentation::recordMoveConstruction();
+        log(": MOVE Constructor from ", original_other_name);
+
+        // nullify the source object's resource pointer and modify its name for tracking its state.
+        other.resource = nullptr;
+        other.name += original_other_name + " [moved]";
+    }
+
+    // Move Assignment Operator
+    BasicTracer& operator=(BasicTracer&& other) noexcept(NoexceptMove) {
+        if (this == &other)
+            return *this;
+        std::string original_other_name = other.name;
+        instrumentation::recordMoveAssignment();
+        log(": MOVE Assignment from ", other.name);
+        releaseResource(resource);
+        resource = other.resource;
+        name = other.name;
+        other.resource = nullptr;
+        other.name += original_other_name + " [moved]";
+        return *this;
+    }
+
+    // Orders by the value of the resource, so containers can sort tracers.
+    friend bool operator<(const BasicTracer& a, const BasicTracer& b) {
+        return *a.resource < *b.resource;
+    }
+
+private:
+    // Every allocation of the resource goes through here so the heap traffic shows up in the counters.
+    static int* allocateResource(int value) {
+        instrumentation::recordAllocation(sizeof(int));
+        return Resource::allocate(value);
+    }
+
+    static void releaseResource(int* res) {
+        if (res == nullptr)
+            return;
+        instrumentation::recordDeallocation(sizeof(int));
+        Resource::deallocate(res);
+    }
+
+    void log(const char* event) const {
+        if (instrumentation::verbose())
+            std::cout << "  " << name << event << '\n';
+    }
+
+    void log(const char* event, const std::string& other_name) const {
+        if (instrumentation::verbose())
+            std::cout << "  " << name << event << other_name << '\n';
+    }
+};
+
+using Tracer = BasicTracer<true>;
+using ThrowingMoveTracer = BasicTracer<false>;
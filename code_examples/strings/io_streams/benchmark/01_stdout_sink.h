@@ -0,0 +1,179 @@
+#include "fd_streambuf.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <print>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Line-oriented output to stdout: "line <n> value <n * 3>\n", 5M lines per case.
+// stdout is redirected to /dev/null (or to the given target file) while a case runs, so the numbers
+// measure the output path and not the terminal.
+class Benchmark_01_Stdout_Sink
+{
+public:
+    explicit Benchmark_01_Stdout_Sink(const char* target = "/dev/null")
+        : m_target(target)
+    {
+    }
+
+    // 1. std::cout synchronized with stdio (the default), C stdio, std::print and FdOutputBuf
+    void RunSynchronized()
+    {
+        run("cout << std::endl (flush per line)", [] {
+            for (std::size_t i = 0; i < kLines; ++i)
+                std::cout << "line " << i << " value " << i * 3 << std::endl;
+            return static_cast<std::size_t>(0);
+        });
+        run("cout << '\\n'", [] {
+            for (std::size_t i = 0; i < kLines; ++i)
+                std::cout << "line " << i << " value " << i * 3 << '\n';
+            std::cout.flush();
+            return static_cast<std::size_t>(0);
+        });
+
+        // C stdio and std::print, all through the FILE* buffer of stdout
+        run("printf", [] {
+            std::size_t bytes = 0;
+            for (std::size_t i = 0; i < kLines; ++i)
+                bytes += static_cast<std::size_t>(std::printf("line %zu value %zu\n", i, i * 3));
+            std::fflush(stdout);
+            return bytes;
+        });
+        run("fwrite of a to_chars line", [] {
+            std::size_t bytes = 0;
+            char line[64];
+            for (std::size_t i = 0; i < kLines; ++i)
+                bytes += std::fwrite(line, 1, formatLine(line, i), stdout);
+            std::fflush(stdout);
+            return bytes;
+        });
+        run("std::print", [] {
+            for (std::size_t i = 0; i < kLines; ++i)
+                std::print("line {} value {}\n", i, i * 3);
+            std::fflush(stdout);
+            return static_cast<std::size_t>(0);
+        });
+
+        // FdOutputBuf: one 1 MiB buffer, write(2) when full
+        run("FdOutputStream << '\\n'", [] {
+            FdOutputStream out;
+            for (std::size_t i = 0; i < kLines; ++i)
+                out << "line " << i << " value " << i * 3 << '\n';
+            out.flush();
+            return static_cast<std::size_t>(0);
+        });
+        run("FdOutputBuf::sputn of a to_chars line", [] {
+            std::size_t bytes = 0;
+            FdOutputBuf out;
+            char line[64];
+            for (std::size_t i = 0; i < kLines; ++i)
+                bytes += static_cast<std::size_t>(out.sputn(line, static_cast<std::streamsize>(formatLine(line, i))));
+            out.pubsync();
+            return bytes;
+        });
+        run("FdOutputBuf, 64 KiB blocks via writev", [] {
+            std::size_t bytes = 0;
+            FdOutputBuf out(STDOUT_FILENO, 64 * 1024);
+            std::string block;
+            char line[64];
+            for (std::size_t i = 0; i < kLines; ++i) {
+                block.append(line, formatLine(line, i));
+                if (block.size() >= 48 * 1024) {
+                    bytes += static_cast<std::size_t>(out.sputn(block.data(), static_cast<std::streamsize>(block.size())));
+                    block.clear();
+                }
+            }
+            bytes += static_cast<std::size_t>(out.sputn(block.data(), static_cast<std::streamsize>(block.size())));
+            out.pubsync();
+            return bytes;
+        });
+    }
+
+    // 2. std::cout after sync_with_stdio(false)
+    void RunUnsynchronized()
+    {
+        run("sync_with_stdio(false), cout << '\\n'", [] {
+            for (std::size_t i = 0; i < kLines; ++i)
+                std::cout << "line " << i << " value " << i * 3 << '\n';
+            std::cout.flush();
+            return static_cast<std::size_t>(0);
+        });
+        run("sync_with_stdio(false), cout << std::endl", [] {
+            for (std::size_t i = 0; i < kLines; ++i)
+                std::cout << "line " << i << " value " << i * 3 << std::endl;
+            return static_cast<std::size_t>(0);
+        });
+    }
+
+    void Print()
+    {
+        // Every case writes the same text, the cases that do not count bytes take them from the one that does.
+        std::size_t bytes = 0;
+        for (const BenchmarkResult& result : m_results)
+            bytes = std::max(bytes, result.bytes);
+        for (BenchmarkResult& result : m_results)
+            result.bytes = bytes;
+
+        printResults("🚀 Output to stdout: 5M lines", "line", kLines, m_results);
+    }
+
+private:
+    static constexpr std::size_t kLines = 5'000'000;
+
+    // Points fd 1 at the target for the duration of one case, and back at the terminal afterwards.
+    class StdoutRedirect
+    {
+    public:
+        explicit StdoutRedirect(const char* target)
+            : m_saved(::dup(STDOUT_FILENO))
+        {
+            int fd = ::open(target, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                std::perror(target);
+                std::exit(1);
+            }
+            ::dup2(fd, STDOUT_FILENO);
+            ::close(fd);
+        }
+
+        ~StdoutRedirect()
+        {
+            ::dup2(m_saved, STDOUT_FILENO);
+            ::close(m_saved);
+        }
+
+    private:
+        int m_saved;
+    };
+
+    // Every case flushes its own buffers before the redirect ends.
+    template <typename Func>
+    void run(std::string name, Func&& writeLines)
+    {
+        StdoutRedirect redirect(m_target);
+        std::size_t bytes = 0;
+        double ms = measureMilliseconds([&] { bytes = writeLines(); });
+        m_results.push_back({std::move(name), ms, bytes});
+    }
+
+    // The line of the formatting-free cases, written with std::to_chars.
+    static std::size_t formatLine(char* buffer, std::size_t i)
+    {
+        char* out = buffer;
+        out = std::char_traits<char>::copy(out, "line ", 5) + 5;
+        out = std::to_chars(out, out + 20, i).ptr;
+        out = std::char_traits<char>::copy(out, " value ", 7) + 7;
+        out = std::to_chars(out, out + 20, i * 3).ptr;
+        *out++ = '\n';
+        return static_cast<std::size_t>(out - buffer);
+    }
+
+    const char* m_target;
+    std::vector<BenchmarkResult> m_results;
+};
@@ -0,0 +1,153 @@
+#include "fd_reader.h"
+#include "fd_streambuf.h"
+#include "benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// Parsing 100M integers from stdin: std::cin >> (synchronized and not), scanf, std::ifstream >> and FdReader.
+// The integers are written to a temporary file once (about 800 MB), stdin is redirected to it for every case.
+class Benchmark_02_Input_Parser
+{
+public:
+    Benchmark_02_Input_Parser()
+        : m_path(std::filesystem::temp_directory_path() / "io_streams_benchmark_integers.txt")
+    {
+    }
+
+    ~Benchmark_02_Input_Parser()
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    // 1. std::cin synchronized with stdio (the default), scanf, ifstream and FdReader
+    void RunSynchronized()
+    {
+        writeInput();
+
+        run("cin >> int", [] {
+            long long sum = 0;
+            int value;
+            while (std::cin >> value)
+                sum += value;
+            return sum;
+        });
+        run("scanf(\"%d\")", [] {
+            long long sum = 0;
+            int value;
+            while (std::scanf("%d", &value) == 1)
+                sum += value;
+            return sum;
+        });
+        run("ifstream >> int", [this] {
+            long long sum = 0;
+            int value;
+            std::ifstream in(m_path);
+            while (in >> value)
+                sum += value;
+            return sum;
+        });
+        run("FdReader::readInt", [] {
+            long long sum = 0;
+            int value;
+            FdReader in(STDIN_FILENO);
+            while (in.readInt(value))
+                sum += value;
+            return sum;
+        });
+    }
+
+    // 2. std::cin after sync_with_stdio(false) and untied from std::cout
+    void RunUnsynchronized()
+    {
+        writeInput();
+
+        std::cin.tie(nullptr);
+        run("sync_with_stdio(false), cin >> int", [] {
+            long long sum = 0;
+            int value;
+            while (std::cin >> value)
+                sum += value;
+            return sum;
+        });
+        std::cin.tie(&std::cout);
+    }
+
+    void Print()
+    {
+        printResults("🚀 Parsing 100M integers from stdin", "int", kIntegers, m_results);
+        for (const Checksum& checksum : m_checksums)
+            if (checksum.sum != m_expectedSum)
+                std::cout << std::format("{}: checksum {} differs from {}\n", checksum.name, checksum.sum, m_expectedSum);
+    }
+
+private:
+    static constexpr std::size_t kIntegers = 100'000'000;
+
+    struct Checksum {
+        std::string name;
+        long long sum;
+    };
+
+    // Ten integers between -1'000'000 and 1'000'000 per line.
+    void writeInput()
+    {
+        if (m_bytes != 0)
+            return;
+
+        int fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::perror(m_path.c_str());
+            std::exit(1);
+        }
+        {
+            FdOutputStream out(fd);
+            for (std::size_t i = 0; i < kIntegers; ++i) {
+                long long value = static_cast<long long>(i * 2654435761ULL % 2'000'001) - 1'000'000;
+                m_expectedSum += value;
+                out << value << (i % 10 == 9 ? '\n' : ' ');
+            }
+        }
+        ::close(fd);
+
+        struct stat info {};
+        ::stat(m_path.c_str(), &info);
+        m_bytes = static_cast<std::size_t>(info.st_size);
+    }
+
+    // Points fd 0 at the input file for one case and resets the stdin state afterwards.
+    template <typename Func>
+    void run(std::string name, Func&& parse)
+    {
+        int saved = ::dup(STDIN_FILENO);
+        int fd = ::open(m_path.c_str(), O_RDONLY);
+        ::dup2(fd, STDIN_FILENO);
+        ::close(fd);
+
+        long long sum = 0;
+        double ms = measureMilliseconds([&] { sum = parse(); });
+
+        ::dup2(saved, STDIN_FILENO);
+        ::close(saved);
+        std::clearerr(stdin);
+        std::cin.clear();
+
+        m_results.push_back({name, ms, m_bytes});
+        m_checksums.push_back({std::move(name), sum});
+    }
+
+    std::filesystem::path m_path;
+    std::size_t m_bytes = 0;
+    long long m_expectedSum = 0;
+    std::vector<BenchmarkResult> m_results;
+    std::vector<Checksum> m_checksums;
+};
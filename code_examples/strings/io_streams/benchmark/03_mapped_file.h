@@ -0,0 +1,151 @@
+#include "fd_reader.h"
+#include "mmap_streambuf.h"
+#include "benchmark.h"
+#include <fcntl.h>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Writing and reading a 2 GiB text file line by line: std::ofstream / std::ifstream against the memory
+// mapped stream buffers. The file is read right after it was written, so the page cache is warm and the
+// numbers show the copies made by each reader, not the disk.
+class Benchmark_03_Mapped_File
+{
+public:
+    Benchmark_03_Mapped_File()
+        : m_path(std::filesystem::temp_directory_path() / "io_streams_benchmark_lines.txt")
+    {
+    }
+
+    ~Benchmark_03_Mapped_File()
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    void Run()
+    {
+        runWrite("ofstream << line", [this] {
+            std::ofstream out(m_path);
+            return writeLines(out);
+        });
+        runWrite("MappedOfstream << line", [this] {
+            MappedOfstream out(m_path);
+            return writeLines(out);
+        });
+
+        runRead("ifstream + getline", [this] {
+            std::ifstream in(m_path);
+            return readLines(in);
+        });
+        runRead("ifstream 1 MiB buffer + getline", [this] {
+            auto buffer = std::make_unique<char[]>(1 << 20);
+            std::ifstream in;
+            in.rdbuf()->pubsetbuf(buffer.get(), 1 << 20);
+            in.open(m_path);
+            return readLines(in);
+        });
+        runRead("MappedIfstream + getline", [this] {
+            MappedIfstream in(m_path);
+            return readLines(in);
+        });
+        runRead("MappedInputBuf::nextLine (string_view)", [this] {
+            MappedInputBuf in(m_path);
+            Count count;
+            std::string_view line;
+            while (in.nextLine(line))
+                count.add(line.size());
+            return count;
+        });
+        runRead("FdReader::readLine", [this] {
+            int fd = ::open(m_path.c_str(), O_RDONLY);
+            FdReader in(fd);
+            Count count;
+            std::string line;
+            while (in.readLine(line))
+                count.add(line.size());
+            ::close(fd);
+            return count;
+        });
+    }
+
+    void Print()
+    {
+        printResults("🚀 Writing a 2 GiB file line by line", "line", m_lines, m_writeResults);
+        printResults("🚀 Reading a 2 GiB file line by line", "line", m_lines, m_readResults);
+        for (const auto& [name, characters] : m_checksums)
+            if (characters != m_characters)
+                std::cout << std::format("{}: read {} characters, expected {}\n", name, characters, m_characters);
+    }
+
+private:
+    static constexpr std::size_t kFileSize = std::size_t{2} << 30;
+
+    struct Count {
+        std::size_t lines = 0;
+        std::size_t characters = 0; // without the newlines
+
+        void add(std::size_t length)
+        {
+            ++lines;
+            characters += length;
+        }
+    };
+
+    // Lines between 20 and 120 characters, like a log file.
+    Count writeLines(std::ostream& out)
+    {
+        std::string text(128, 'x');
+        Count count;
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; bytes < kFileSize; ++i) {
+            std::string_view line(text.data(), 20 + i * 7919 % 101);
+            out << line << '\n';
+            count.add(line.size());
+            bytes += line.size() + 1;
+        }
+        return count;
+    }
+
+    Count readLines(std::istream& in)
+    {
+        Count count;
+        std::string line;
+        while (std::getline(in, line))
+            count.add(line.size());
+        return count;
+    }
+
+    template <typename Func>
+    void runWrite(std::string name, Func&& write)
+    {
+        Count count;
+        double ms = measureMilliseconds([&] { count = write(); });
+        m_lines = count.lines;
+        m_characters = count.characters;
+        m_writeResults.push_back({std::move(name), ms, count.lines + count.characters});
+    }
+
+    template <typename Func>
+    void runRead(std::string name, Func&& read)
+    {
+        Count count;
+        double ms = measureMilliseconds([&] { count = read(); });
+        m_readResults.push_back({name, ms, count.lines + count.characters});
+        m_checksums.emplace_back(std::move(name), count.characters);
+    }
+
+    std::filesystem::path m_path;
+    std::size_t m_lines = 0;
+    std::size_t m_characters = 0;
+    std::vector<BenchmarkResult> m_writeResults;
+    std::vector<BenchmarkResult> m_readResults;
+    std::vector<std::pair<std::string, std::size_t>> m_checksums;
+};
@@ -0,0 +1,119 @@
+#include "async_logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fcntl.h>
+#include <format>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Latency of a single log call while several threads log as fast as they can: std::cerr, std::clog and
+// AsyncLogger (both overflow policies, called directly and through std::clog). Throughput hides the
+// stalls that matter on a hot path, so every call is timed and the table shows percentiles.
+// stderr is redirected to /dev/null, the numbers measure the logging path and not the terminal.
+class Benchmark_04_Async_Logger
+{
+public:
+    void Run()
+    {
+        int saved = ::dup(STDERR_FILENO);
+        int null = ::open("/dev/null", O_WRONLY);
+        ::dup2(null, STDERR_FILENO);
+        ::close(null);
+
+        run("cerr << message", [](int thread, int i) {
+            std::cerr << "worker " << thread << " processed item " << i << '\n';
+        });
+        run("clog << message", [](int thread, int i) {
+            std::clog << "worker " << thread << " processed item " << i << '\n';
+        });
+        {
+            AsyncLogger logger({.policy = OverflowPolicy::Drop});
+            run("AsyncLogger::log, drop when full", [&](int thread, int i) {
+                logger.log(LogLevel::Info, "worker {} processed item {}", thread, i);
+            }, &logger);
+        }
+        {
+            AsyncLogger logger({.policy = OverflowPolicy::Block});
+            run("AsyncLogger::log, block when full", [&](int thread, int i) {
+                logger.log(LogLevel::Info, "worker {} processed item {}", thread, i);
+            }, &logger);
+        }
+        {
+            AsyncLogger logger({.policy = OverflowPolicy::Block});
+            ScopedLogRedirect redirect(logger, LogLevel::Info, std::clog);
+            run("clog << message into AsyncLogger", [](int thread, int i) {
+                std::clog << "worker " << thread << " processed item " << i << '\n';
+            }, &logger);
+        }
+
+        ::dup2(saved, STDERR_FILENO);
+        ::close(saved);
+    }
+
+    void Print()
+    {
+        std::cout << std::format("\n🚀 Log call latency, {} threads x {} messages\n", kThreads, kMessages);
+        std::cout << std::format("{:<36} {:>9} {:>9} {:>9} {:>9} {:>10} {:>9}\n", "method", "p50 ns", "p99 ns",
+                                 "p99.9 ns", "max ns", "total ms", "dropped");
+        std::cout << std::string(97, '-') << '\n';
+        for (const Result& result : m_results)
+            std::cout << std::format("{:<36} {:>9} {:>9} {:>9} {:>9} {:>10.1f} {:>9}\n", result.name, result.p50,
+                                     result.p99, result.p999, result.max, result.ms, result.dropped);
+        std::cout.flush();
+    }
+
+private:
+    static constexpr int kThreads = 4;
+    static constexpr int kMessages = 1'000'000;
+
+    struct Result {
+        std::string name;
+        std::int64_t p50, p99, p999, max;
+        double ms;
+        std::uint64_t dropped;
+    };
+
+    // The total time includes writing everything the logger still had buffered.
+    template <typename Func>
+    void run(std::string name, Func&& log, AsyncLogger* logger = nullptr)
+    {
+        std::vector<std::vector<std::int64_t>> latencies(kThreads);
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> workers;
+            for (int thread = 0; thread < kThreads; ++thread) {
+                workers.emplace_back([&, thread] {
+                    std::vector<std::int64_t>& samples = latencies[thread];
+                    samples.reserve(kMessages);
+                    for (int i = 0; i < kMessages; ++i) {
+                        auto before = std::chrono::steady_clock::now();
+                        log(thread, i);
+                        auto after = std::chrono::steady_clock::now();
+                        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+                    }
+                });
+            }
+        }
+        std::cerr.flush();
+        std::clog.flush();
+        if (logger != nullptr)
+            logger->flush();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<std::int64_t> all;
+        all.reserve(static_cast<std::size_t>(kThreads) * kMessages);
+        for (const std::vector<std::int64_t>& samples : latencies)
+            all.insert(all.end(), samples.begin(), samples.end());
+        std::sort(all.begin(), all.end());
+        auto percentile = [&](double p) { return all[static_cast<std::size_t>(p * static_cast<double>(all.size() - 1))]; };
+
+        m_results.push_back({std::move(name), percentile(0.5), percentile(0.99), percentile(0.999), all.back(), ms,
+                             logger != nullptr ? logger->dropped() : 0});
+    }
+
+    std::vector<Result> m_results;
+};
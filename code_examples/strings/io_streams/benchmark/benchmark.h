@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct BenchmarkResult {
+    std::string name;
+    double ms = 0.0;
+    std::size_t bytes = 0;
+};
+
+template <typename Func>
+double measureMilliseconds(Func&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// One row per result: total time, time per item (line, integer, ...) and throughput.
+inline void printResults(std::string_view title, std::string_view item, std::size_t items, const std::vector<BenchmarkResult>& results)
+{
+    std::cout << std::format("\n{}\n", title);
+    std::cout << std::format("{:<44} {:>10} {:>10} {:>10}\n", "method", "ms", std::format("ns/{}", item), "MB/s");
+    std::cout << std::string(77, '-') << '\n';
+    for (const BenchmarkResult& result : results)
+        std::cout << std::format("{:<44} {:>10.1f} {:>10.1f} {:>10.1f}\n", result.name, result.ms,
+                                 result.ms * 1'000'000.0 / items, result.bytes / 1'000.0 / result.ms);
+    std::cout.flush();
+}
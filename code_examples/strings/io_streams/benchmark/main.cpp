@@ -0,0 +1,55 @@
+#include "01_stdout_sink.h"
+#include "02_input_parser.h"
+#include "03_mapped_file.h"
+#include "04_async_logger.h"
+#include <cstdlib>
+#include <iostream>
+
+// Build with the release preset. Pass a benchmark id to run a single one, 0 runs all of them.
+// A second argument is the file the stdout benchmark writes to instead of /dev/null.
+int main(int argc, char* argv[])
+{
+    int benchmarkId = 0;
+    const char* stdoutTarget = "/dev/null";
+
+    if (argc > 1)
+        benchmarkId = std::atoi(argv[1]);
+    if (argc > 2)
+        stdoutTarget = argv[2];
+
+    Benchmark_01_Stdout_Sink benchmark1(stdoutTarget);
+    Benchmark_02_Input_Parser benchmark2;
+    Benchmark_03_Mapped_File benchmark3;
+    Benchmark_04_Async_Logger benchmark4;
+
+    // sync_with_stdio(false) cannot be undone, and calling it after I/O is implementation-defined
+    // (libstdc++ gives cin and cout their own filebufs). Every benchmark therefore measures the
+    // synchronized streams first, then all of them switch together.
+    if (benchmarkId == 0 || benchmarkId == 1)
+        benchmark1.RunSynchronized();
+    if (benchmarkId == 0 || benchmarkId == 2)
+        benchmark2.RunSynchronized();
+    if (benchmarkId == 0 || benchmarkId == 3)
+        benchmark3.Run();
+    if (benchmarkId == 0 || benchmarkId == 4)
+        benchmark4.Run();
+
+    std::cout.flush();
+    std::ios::sync_with_stdio(false);
+
+    if (benchmarkId == 0 || benchmarkId == 1)
+        benchmark1.RunUnsynchronized();
+    if (benchmarkId == 0 || benchmarkId == 2)
+        benchmark2.RunUnsynchronized();
+
+    if (benchmarkId == 0 || benchmarkId == 1)
+        benchmark1.Print();
+    if (benchmarkId == 0 || benchmarkId == 2)
+        benchmark2.Print();
+    if (benchmarkId == 0 || benchmarkId == 3)
+        benchmark3.Print();
+    if (benchmarkId == 0 || benchmarkId == 4)
+        benchmark4.Print();
+
+    return 0;
+}
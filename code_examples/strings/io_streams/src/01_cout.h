@@ -129,6 +129,7 @@ private:
         
         // std::endl inserts '\n' AND forces a slow buffer flush. Avoid in loops.
         std::cout << "Use std::endl only when you must flush." << std::endl;
+        // benchmark/01_stdout_sink.h measures endl against '\n', printf, std::print, fwrite and FdOutputBuf.
     }
     
     // 13. Why would you use cout.put() instead of << for a character?
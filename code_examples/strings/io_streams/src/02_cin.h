@@ -81,6 +81,7 @@ private:
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // 2. Discard the bad input.
         }
         std::cout << "You entered the valid number: " << number << "\n";
+        // FdReader in fd_reader.h follows the same protocol for large inputs: readInt(), clear(), ignoreLine().
     }
 
     // Question: How can you read the very next character, even if it's a space?
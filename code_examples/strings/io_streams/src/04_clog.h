@@ -7,6 +7,9 @@ public:
     void Run() 
     {
         // Use clog for detailed, non-critical progress updates.
+        // clog still formats and writes on the calling thread. For logging from hot paths see AsyncLogger
+        // in async_logger.h: std::clog.rdbuf() can be pointed at it without changing these lines
+        // (benchmark 4 measures the latency of both).
         std::clog << "LOG: Task started. Preparing stage 1...\n";
         std::clog << "LOG: computation...\n";
         std::clog << "LOG: Task finished.\n";
@@ -0,0 +1,479 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+// A logger that never waits for the terminal or the disk on the logging thread.
+// std::cerr writes every message immediately, std::clog buffers but still writes from the calling thread.
+// AsyncLogger copies each message into a ring buffer owned by the calling thread, a background thread
+// drains all rings and writes them in batches. When a ring is full the message is either dropped
+// (counted and reported later) or the caller waits for the flusher, see OverflowPolicy.
+// Error messages are never dropped: log() only returns once an error and everything logged before it
+// has been written, so it reaches the file descriptor even if the process crashes or calls _exit
+// right after. Everything else still buffered is written when the logger is destroyed (including at
+// exit for a static logger) and, after installCrashHandler(), from the handler of a fatal signal.
+enum class LogLevel : std::uint8_t { Debug, Info, Warning, Error };
+
+enum class OverflowPolicy {
+    Drop,  // the hot thread never waits, messages below Error are lost under overload
+    Block, // no message is lost, the hot thread waits while its ring is full
+};
+
+class AsyncLogger
+{
+public:
+    struct Options {
+        int fd = STDERR_FILENO;
+        std::size_t ringCapacity = 1 << 20; // bytes per thread, rounded up to a power of two
+        OverflowPolicy policy = OverflowPolicy::Drop;
+        LogLevel minimumLevel = LogLevel::Debug;
+        std::chrono::milliseconds flushInterval{50};
+    };
+
+    AsyncLogger()
+        : AsyncLogger(Options{})
+    {
+    }
+
+    explicit AsyncLogger(Options options)
+        : m_options(options), m_id(s_nextId.fetch_add(1, std::memory_order_relaxed))
+    {
+        std::size_t capacity = 1024;
+        while (capacity < m_options.ringCapacity)
+            capacity *= 2;
+        m_options.ringCapacity = capacity;
+        m_flusher = std::thread([this] { flushLoop(); });
+    }
+
+    ~AsyncLogger()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_flusher.join();
+
+        AsyncLogger* self = this;
+        s_crashLogger.compare_exchange_strong(self, nullptr);
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Returns false when the message was dropped because the ring of this thread was full.
+    // An error waits for room regardless of the policy and returns once it has been written.
+    bool log(LogLevel level, std::string_view message)
+    {
+        if (level < m_options.minimumLevel)
+            return true;
+
+        ThreadBuffer* buffer = threadBuffer();
+        if (buffer == nullptr)
+            return false;
+
+        // A single message may use at most half of the ring, longer ones are truncated.
+        message = message.substr(0, std::min(message.size(), m_options.ringCapacity / 2 - sizeof(RecordHeader)));
+        RecordHeader header{static_cast<std::uint32_t>(message.size()), level,
+                            std::chrono::system_clock::now().time_since_epoch().count()};
+
+        while (!buffer->push(header, message)) {
+            if (m_options.policy == OverflowPolicy::Drop && level != LogLevel::Error) {
+                buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+                requestFlush();
+                return false;
+            }
+            requestFlush();
+            std::this_thread::yield();
+        }
+
+        if (level == LogLevel::Error)
+            flush();
+        else if (buffer->size() > m_options.ringCapacity / 2)
+            requestFlush();
+        return true;
+    }
+
+    template <typename... Args>
+    bool log(LogLevel level, std::format_string<Args...> format, Args&&... args)
+    {
+        if (level < m_options.minimumLevel)
+            return true;
+        char text[512];
+        auto result = std::format_to_n(text, sizeof(text), format, std::forward<Args>(args)...);
+        return log(level, std::string_view(text, std::min<std::size_t>(result.size, sizeof(text))));
+    }
+
+    // Blocks until everything logged by any thread before the call has been written.
+    void flush()
+    {
+        std::unique_lock lock(m_mutex);
+        std::uint64_t target = ++m_flushRequests;
+        m_wakeRequested.store(true, std::memory_order_relaxed);
+        m_wake.notify_one();
+        m_flushed.wait(lock, [&] { return m_flushesDone >= target; });
+    }
+
+    std::uint64_t dropped() const { return m_totalDropped.load(std::memory_order_relaxed); }
+
+    // Writes the buffered messages of this logger from SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT
+    // before the default action runs. Best effort: the handler only uses write(2), and a flush running
+    // at the same time may write a message twice.
+    void installCrashHandler()
+    {
+        s_crashLogger.store(this, std::memory_order_release);
+        for (int signal : {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT}) {
+            struct sigaction action {};
+            action.sa_handler = &AsyncLogger::onFatalSignal;
+            sigemptyset(&action.sa_mask);
+            action.sa_flags = SA_RESETHAND;
+            sigaction(signal, &action, nullptr);
+        }
+    }
+
+private:
+    static constexpr std::size_t kMaxThreads = 256;
+
+    struct RecordHeader {
+        std::uint32_t length;
+        LogLevel level;
+        std::int64_t time; // system_clock ticks
+    };
+
+    // Single producer (the owning thread), single consumer (the flusher) byte ring.
+    // head and tail only grow, their difference is the number of used bytes.
+    struct ThreadBuffer {
+        explicit ThreadBuffer(std::size_t capacity)
+            : data(std::make_unique<char[]>(capacity)), capacity(capacity)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed);
+        }
+
+        bool push(const RecordHeader& header, std::string_view message)
+        {
+            std::size_t end = tail.load(std::memory_order_relaxed);
+            std::size_t needed = sizeof(header) + message.size();
+            if (needed > capacity - (end - head.load(std::memory_order_acquire)))
+                return false;
+            copyIn(end, &header, sizeof(header));
+            copyIn(end + sizeof(header), message.data(), message.size());
+            tail.store(end + needed, std::memory_order_release);
+            return true;
+        }
+
+        // Calls consume(header, first part, second part) for every record, the message may wrap around.
+        template <typename Consume>
+        void drain(Consume&& consume)
+        {
+            std::size_t start = head.load(std::memory_order_relaxed);
+            std::size_t end = tail.load(std::memory_order_acquire);
+            while (start < end) {
+                RecordHeader header;
+                copyOut(start, &header, sizeof(header));
+                std::size_t offset = (start + sizeof(header)) & (capacity - 1);
+                std::size_t first = std::min<std::size_t>(header.length, capacity - offset);
+                consume(header, std::string_view(data.get() + offset, first),
+                        std::string_view(data.get(), header.length - first));
+                start += sizeof(header) + header.length;
+            }
+            head.store(start, std::memory_order_release);
+        }
+
+        void copyIn(std::size_t position, const void* source, std::size_t count)
+        {
+            std::size_t offset = position & (capacity - 1);
+            std::size_t first = std::min(count, capacity - offset);
+            std::memcpy(data.get() + offset, source, first);
+            std::memcpy(data.get(), static_cast<const char*>(source) + first, count - first);
+        }
+
+        void copyOut(std::size_t position, void* target, std::size_t count) const
+        {
+            std::size_t offset = position & (capacity - 1);
+            std::size_t first = std::min(count, capacity - offset);
+            std::memcpy(target, data.get() + offset, first);
+            std::memcpy(static_cast<char*>(target) + first, data.get(), count - first);
+        }
+
+        std::unique_ptr<char[]> data;
+        std::size_t capacity;
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<bool> abandoned{false}; // the owning thread has exited
+    };
+
+    // Each thread keeps the ring it registered with its current logger. When the thread exits the ring
+    // is marked abandoned, the flusher writes what is left and releases it.
+    struct ThreadHandle {
+        std::uint64_t loggerId = 0;
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~ThreadHandle()
+        {
+            if (buffer)
+                buffer->abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    ThreadBuffer* threadBuffer()
+    {
+        thread_local ThreadHandle handle;
+        if (handle.loggerId == m_id)
+            return handle.buffer.get();
+
+        if (handle.buffer)
+            handle.buffer->abandoned.store(true, std::memory_order_release);
+        handle.loggerId = m_id;
+        handle.buffer = std::make_shared<ThreadBuffer>(m_options.ringCapacity);
+
+        std::lock_guard lock(m_mutex);
+        m_buffers.push_back(handle.buffer);
+        for (std::atomic<ThreadBuffer*>& slot : m_crashView) {
+            ThreadBuffer* expected = nullptr;
+            if (slot.compare_exchange_strong(expected, handle.buffer.get()))
+                break;
+        }
+        return handle.buffer.get();
+    }
+
+    void requestFlush()
+    {
+        if (!m_wakeRequested.exchange(true, std::memory_order_relaxed))
+            m_wake.notify_one();
+    }
+
+    void flushLoop()
+    {
+        std::string batch;
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_wake.wait_for(lock, m_options.flushInterval, [&] {
+                return m_stop || m_wakeRequested.load(std::memory_order_relaxed);
+            });
+            m_wakeRequested.store(false, std::memory_order_relaxed);
+            bool stop = m_stop;
+            std::uint64_t requests = m_flushRequests;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers = m_buffers;
+            lock.unlock();
+
+            // Format and write without holding the lock, producers only need it to register.
+            for (const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+                drainInto(*buffer, batch);
+            writeAll(m_options.fd, batch);
+            batch.clear();
+
+            lock.lock();
+            releaseAbandoned();
+            m_flushesDone = requests;
+            m_flushed.notify_all();
+            if (stop)
+                return;
+        }
+    }
+
+    void drainInto(ThreadBuffer& buffer, std::string& batch)
+    {
+        buffer.drain([&](const RecordHeader& header, std::string_view first, std::string_view second) {
+            using namespace std::chrono;
+            auto time = floor<microseconds>(system_clock::time_point(system_clock::duration(header.time)));
+            std::format_to(std::back_inserter(batch), "{:%F %T} [{}] ", time, levelTag(header.level));
+            batch.append(first).append(second).push_back('\n');
+        });
+        if (std::uint64_t dropped = buffer.dropped.exchange(0, std::memory_order_relaxed)) {
+            m_totalDropped.fetch_add(dropped, std::memory_order_relaxed);
+            batch += std::format("[W] {} messages dropped, log ring full\n", dropped);
+        }
+    }
+
+    // Called with the lock held: drops the rings of exited threads once they are empty.
+    void releaseAbandoned()
+    {
+        std::erase_if(m_buffers, [&](const std::shared_ptr<ThreadBuffer>& buffer) {
+            if (!buffer->abandoned.load(std::memory_order_acquire) || buffer->size() != 0)
+                return false;
+            for (std::atomic<ThreadBuffer*>& slot : m_crashView) {
+                ThreadBuffer* expected = buffer.get();
+                slot.compare_exchange_strong(expected, nullptr);
+            }
+            return true;
+        });
+    }
+
+    static char levelTag(LogLevel level)
+    {
+        constexpr char kTags[] = {'D', 'I', 'W', 'E'};
+        return kTags[static_cast<std::size_t>(level)];
+    }
+
+    static void writeAll(int fd, std::string_view text)
+    {
+        while (!text.empty()) {
+            ssize_t written = ::write(fd, text.data(), text.size());
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                return;
+            }
+            text.remove_prefix(static_cast<std::size_t>(written));
+        }
+    }
+
+    // Only async-signal-safe calls: no allocation, no locks, no formatting, only write(2).
+    static void onFatalSignal(int signal)
+    {
+        if (AsyncLogger* logger = s_crashLogger.load(std::memory_order_acquire)) {
+            writeAll(logger->m_options.fd, "[E] fatal signal, flushing log buffers\n");
+            for (std::atomic<ThreadBuffer*>& slot : logger->m_crashView) {
+                ThreadBuffer* buffer = slot.load(std::memory_order_acquire);
+                if (buffer == nullptr)
+                    continue;
+                buffer->drain([&](const RecordHeader& header, std::string_view first, std::string_view second) {
+                    char tag[4] = {'[', levelTag(header.level), ']', ' '};
+                    writeAll(logger->m_options.fd, std::string_view(tag, sizeof(tag)));
+                    writeAll(logger->m_options.fd, first);
+                    writeAll(logger->m_options.fd, second);
+                    writeAll(logger->m_options.fd, "\n");
+                });
+            }
+        }
+        std::raise(signal); // SA_RESETHAND restored the default action
+    }
+
+    inline static std::atomic<std::uint64_t> s_nextId{1};
+    inline static std::atomic<AsyncLogger*> s_crashLogger{nullptr};
+
+    Options m_options;
+    const std::uint64_t m_id;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    std::atomic<bool> m_wakeRequested{false};
+    bool m_stop = false;
+    std::uint64_t m_flushRequests = 0;
+    std::uint64_t m_flushesDone = 0;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+    std::array<std::atomic<ThreadBuffer*>, kMaxThreads> m_crashView{};
+    std::atomic<std::uint64_t> m_totalDropped{0};
+
+    std::thread m_flusher;
+};
+
+// A streambuf that turns every line written to it into one log message of a fixed level.
+// std::clog.rdbuf(&buffer) sends all existing std::clog output through the logger. Lines are assembled
+// per buffer and thread, so concurrent writers do not interleave inside a message.
+class LogStreamBuf : public std::streambuf
+{
+public:
+    LogStreamBuf(AsyncLogger& logger, LogLevel level)
+        : m_logger(logger), m_level(level), m_id(s_nextId.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+        char c = traits_type::to_char_type(ch);
+        xsputn(&c, 1);
+        return ch;
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override
+    {
+        std::string& line = currentLine();
+        std::string_view text(data, static_cast<std::size_t>(count));
+        for (std::size_t newline; (newline = text.find('\n')) != std::string_view::npos;) {
+            line.append(text.substr(0, newline));
+            m_logger.log(m_level, line);
+            line.clear();
+            text.remove_prefix(newline + 1);
+        }
+        line.append(text);
+        return count;
+    }
+
+    // A flush (std::flush, std::endl, unitbuf) emits a partial line as its own message.
+    int sync() override
+    {
+        std::string& line = currentLine();
+        if (!line.empty()) {
+            m_logger.log(m_level, line);
+            line.clear();
+        }
+        return 0;
+    }
+
+private:
+    // The partial line of the calling thread for this buffer, in thread-local storage: no lock on the
+    // hot path, and the lines go away with their thread. Buffers are keyed by an id that is never
+    // reused, so a new buffer at the address of a destroyed one does not inherit its partial line.
+    // The last line used is cached, a thread writing to one stream skips the map lookup.
+    std::string& currentLine()
+    {
+        thread_local std::unordered_map<std::uint64_t, std::string> lines;
+        thread_local std::uint64_t lastId = 0;
+        thread_local std::string* last = nullptr;
+        if (lastId != m_id) {
+            last = &lines[m_id]; // node based, the pointer stays valid while other entries are added
+            lastId = m_id;
+        }
+        return *last;
+    }
+
+    inline static std::atomic<std::uint64_t> s_nextId{1};
+
+    AsyncLogger& m_logger;
+    LogLevel m_level;
+    const std::uint64_t m_id;
+};
+
+// Redirects a stream (std::clog by default) into the logger for the lifetime of the object.
+class ScopedLogRedirect
+{
+public:
+    ScopedLogRedirect(AsyncLogger& logger, LogLevel level, std::ostream& stream)
+        : m_buffer(logger, level), m_stream(stream), m_previous(stream.rdbuf(&m_buffer))
+    {
+    }
+
+    ~ScopedLogRedirect()
+    {
+        m_stream.flush();
+        m_stream.rdbuf(m_previous);
+    }
+
+    ScopedLogRedirect(const ScopedLogRedirect&) = delete;
+    ScopedLogRedirect& operator=(const ScopedLogRedirect&) = delete;
+
+private:
+    LogStreamBuf m_buffer;
+    std::ostream& m_stream;
+    std::streambuf* m_previous;
+};
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unistd.h>
+
+// A buffered reader for large text inputs on stdin or any file descriptor.
+// Every std::cin >> builds a sentry, skips whitespace through the locale's ctype facet and, while
+// synchronized with stdio, reads through the FILE* of stdin. FdReader pulls big blocks with read(2)
+// and parses tokens in place with std::from_chars.
+// The error state follows the streams:
+// - fail() after a token that is not a number (the value is set to 0 and the token stays unread,
+//   clear() and ignoreLine() skip it), after an out of range number (the value is set to the min or
+//   max, like operator>>; a double that underflows is stored as 0 or a denormal without failing)
+//   and after a read that found nothing but the end of the input
+// - eof() once the end of the input was reached, a last token without a trailing newline still succeeds
+// - bad() when read(2) fails
+// Like a stream in the fail state, every read does nothing until clear() is called.
+// Numbers use the syntax of from_chars rather than of the locale: "inf" and "nan" are accepted,
+// thousands separators are not. A negative number read into an unsigned type wraps, like operator>>.
+class FdReader
+{
+public:
+    static constexpr std::size_t kDefaultBufferSize = 1 << 20;
+
+    explicit FdReader(int fd = STDIN_FILENO, std::size_t bufferSize = kDefaultBufferSize)
+        : m_fd(fd), m_buffer(std::make_unique<char[]>(bufferSize)), m_capacity(bufferSize)
+    {
+    }
+
+    FdReader(const FdReader&) = delete;
+    FdReader& operator=(const FdReader&) = delete;
+
+    template <std::integral Integer>
+    bool readInt(Integer& value)
+    {
+        return readNumber(value);
+    }
+
+    bool readDouble(double& value)
+    {
+        return readNumber(value);
+    }
+
+    // Reads the next whitespace separated word, like std::cin >> std::string.
+    bool readWord(std::string& word)
+    {
+        if (!skipWhitespace())
+            return false;
+        word.clear();
+        for (;;) {
+            const char* start = m_buffer.get() + m_pos;
+            std::size_t length = 0;
+            while (m_pos + length < m_end && !isSpace(start[length]))
+                ++length;
+            word.append(start, length);
+            m_pos += length;
+            if (m_pos < m_end)
+                return true;
+            if (!refill()) {
+                m_eof = true;
+                return true;
+            }
+        }
+    }
+
+    // Reads up to the next '\n' and consumes it, like std::getline. Fails only when nothing was left to read.
+    bool readLine(std::string& line)
+    {
+        if (!prepareUnformatted())
+            return false;
+        line.clear();
+        for (;;) {
+            std::string_view available(m_buffer.get() + m_pos, m_end - m_pos);
+            std::size_t newline = available.find('\n');
+            if (newline != std::string_view::npos) {
+                line.append(available.substr(0, newline));
+                m_pos += newline + 1;
+                return true;
+            }
+            line.append(available);
+            m_pos = m_end;
+            if (!refill()) {
+                m_eof = true;
+                return true;
+            }
+        }
+    }
+
+    // Reads the next character without skipping whitespace, like std::cin.get(ch).
+    bool get(char& ch)
+    {
+        if (!prepareUnformatted())
+            return false;
+        ch = m_buffer[m_pos++];
+        return true;
+    }
+
+    // Skips the rest of the current line including the '\n',
+    // like std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n').
+    void ignoreLine()
+    {
+        while (!m_bad) {
+            if (m_pos == m_end && !refill()) {
+                m_eof = true;
+                return;
+            }
+            std::string_view available(m_buffer.get() + m_pos, m_end - m_pos);
+            std::size_t newline = available.find('\n');
+            if (newline != std::string_view::npos) {
+                m_pos += newline + 1;
+                return;
+            }
+            m_pos = m_end;
+        }
+    }
+
+    bool good() const { return !m_fail && !m_bad && !m_eof; }
+    bool fail() const { return m_fail || m_bad; }
+    bool eof() const { return m_eof; }
+    bool bad() const { return m_bad; }
+    explicit operator bool() const { return !fail(); }
+
+    // Like std::cin.clear(), reading again after the end of the input asks the descriptor again.
+    void clear()
+    {
+        m_fail = m_bad = m_eof = m_inputEnd = false;
+    }
+
+private:
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // Moves the unread bytes to the front and appends the next block.
+    // Returns false at the end of the input or on a read error (bad).
+    bool refill()
+    {
+        if (m_inputEnd || m_bad)
+            return false;
+        if (m_pos > 0) {
+            std::char_traits<char>::move(m_buffer.get(), m_buffer.get() + m_pos, m_end - m_pos);
+            m_end -= m_pos;
+            m_pos = 0;
+        }
+        for (;;) {
+            ssize_t count = ::read(m_fd, m_buffer.get() + m_end, m_capacity - m_end);
+            if (count > 0) {
+                m_end += static_cast<std::size_t>(count);
+                return true;
+            }
+            if (count < 0 && errno == EINTR)
+                continue;
+            (count == 0 ? m_inputEnd : m_bad) = true;
+            return false;
+        }
+    }
+
+    // Like a stream sentry: fails on an error state, or when only whitespace is left.
+    bool skipWhitespace()
+    {
+        if (m_fail || m_bad) {
+            m_fail = true;
+            return false;
+        }
+        for (;;) {
+            while (m_pos < m_end && isSpace(m_buffer[m_pos]))
+                ++m_pos;
+            if (m_pos < m_end)
+                return true;
+            if (!refill()) {
+                m_eof = m_fail = true;
+                return false;
+            }
+        }
+    }
+
+    // Like the sentry of an unformatted read: fails on any error state or at the end of the input.
+    bool prepareUnformatted()
+    {
+        if (!good()) {
+            m_fail = true;
+            return false;
+        }
+        if (m_pos == m_end && !refill()) {
+            m_eof = m_fail = true;
+            return false;
+        }
+        return true;
+    }
+
+    template <typename Number>
+    bool readNumber(Number& value)
+    {
+        if (!skipWhitespace())
+            return false;
+
+        // from_chars needs the whole token in the buffer: refill until it ends or the input does.
+        std::size_t tokenEnd = m_pos;
+        for (;;) {
+            while (tokenEnd < m_end && !isSpace(m_buffer[tokenEnd]))
+                ++tokenEnd;
+            if (tokenEnd < m_end || m_end - m_pos == m_capacity)
+                break;
+            std::size_t offset = tokenEnd - m_pos;
+            bool more = refill(); // moves the token to the front of the buffer, even at the end of the input
+            tokenEnd = m_pos + offset;
+            if (!more)
+                break;
+        }
+
+        // operator>> accepts a leading '+', from_chars does not.
+        const char* first = m_buffer.get() + m_pos;
+        const char* last = m_buffer.get() + tokenEnd;
+        if (first + 1 < last && *first == '+' && first[1] != '-')
+            ++first;
+        bool negative = *first == '-';
+
+        // operator>> reads "-5" into an unsigned type as well: it negates the magnitude modulo 2^N.
+        // from_chars rejects the sign, so parse the magnitude and negate it here.
+        bool negateUnsigned = false;
+        if constexpr (std::unsigned_integral<Number>) {
+            if (negative && first + 1 < last && first[1] != '-' && first[1] != '+') {
+                ++first;
+                negateUnsigned = true;
+            }
+        }
+
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec == std::errc::invalid_argument) {
+            value = 0; // like operator>> since C++11
+            m_fail = true;
+            return false;
+        }
+        m_pos = static_cast<std::size_t>(ptr - m_buffer.get());
+        // Like num_get, eof is only set when the number itself ran up to the end of the input.
+        if (m_pos == m_end && m_inputEnd)
+            m_eof = true;
+        if (ec == std::errc::result_out_of_range) {
+            if constexpr (std::floating_point<Number>) {
+                // from_chars reports underflow as well, operator>> (strtod) stores 0 or a denormal
+                // there and only fails on overflow.
+                value = std::strtod(std::string(first, ptr).c_str(), nullptr);
+                if (!std::isinf(value))
+                    return true;
+            }
+            value = negative && !negateUnsigned ? std::numeric_limits<Number>::lowest() : std::numeric_limits<Number>::max();
+            m_fail = true;
+            return false;
+        }
+        if (negateUnsigned)
+            value = static_cast<Number>(Number(0) - value);
+        return true;
+    }
+
+    int m_fd;
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_pos = 0; // next unread byte
+    std::size_t m_end = 0; // end of the bytes read so far
+    bool m_fail = false;
+    bool m_eof = false;
+    bool m_bad = false;
+    bool m_inputEnd = false; // read(2) returned 0
+};
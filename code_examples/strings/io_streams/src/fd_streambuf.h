@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// An output streambuf that writes straight to a file descriptor with write(2).
+// std::cout is synchronized with C stdio by default and goes through the FILE* buffer of stdout
+// (or, after sync_with_stdio(false), through a small filebuf). FdOutputBuf owns one large buffer and
+// only calls into the kernel when it is full, on flush or on destruction.
+// Blocks larger than half the buffer are not copied: the buffered bytes and the block are handed to the
+// kernel together with a single writev(2).
+class FdOutputBuf : public std::streambuf
+{
+public:
+    static constexpr std::size_t kDefaultBufferSize = 1 << 20;
+
+    explicit FdOutputBuf(int fd = STDOUT_FILENO, std::size_t bufferSize = kDefaultBufferSize)
+        : m_fd(fd), m_buffer(std::make_unique<char[]>(bufferSize)), m_size(bufferSize)
+    {
+        setp(m_buffer.get(), m_buffer.get() + m_size);
+    }
+
+    ~FdOutputBuf() override
+    {
+        flushBuffer();
+    }
+
+    FdOutputBuf(const FdOutputBuf&) = delete;
+    FdOutputBuf& operator=(const FdOutputBuf&) = delete;
+
+    int fd() const { return m_fd; }
+
+    // Number of write/writev system calls so far.
+    std::size_t syscalls() const { return m_syscalls; }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!flushBuffer())
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override
+    {
+        std::size_t size = static_cast<std::size_t>(count);
+        std::size_t available = static_cast<std::size_t>(epptr() - pptr());
+        if (size <= available) {
+            traits_type::copy(pptr(), data, size);
+            pbump(static_cast<int>(size));
+            return count;
+        }
+
+        // Small blocks: fill the buffer, flush, continue.
+        if (size < m_size / 2) {
+            traits_type::copy(pptr(), data, available);
+            pbump(static_cast<int>(available));
+            if (!flushBuffer())
+                return static_cast<std::streamsize>(available);
+            traits_type::copy(pptr(), data + available, size - available);
+            pbump(static_cast<int>(size - available));
+            return count;
+        }
+
+        // Large blocks: one writev with the buffered bytes and the caller's block, no copy.
+        iovec parts[2] = {
+            {pbase(), static_cast<std::size_t>(pptr() - pbase())},
+            {const_cast<char*>(data), size},
+        };
+        bool ok = writeAll(parts, 2);
+        setp(m_buffer.get(), m_buffer.get() + m_size); // like flushBuffer: the buffered bytes are dropped on failure
+        return ok ? count : 0;
+    }
+
+    int sync() override
+    {
+        return flushBuffer() ? 0 : -1;
+    }
+
+private:
+    bool flushBuffer()
+    {
+        iovec part = {pbase(), static_cast<std::size_t>(pptr() - pbase())};
+        bool ok = part.iov_len == 0 || writeAll(&part, 1);
+        setp(m_buffer.get(), m_buffer.get() + m_size);
+        return ok;
+    }
+
+    // Retries partial writes and EINTR until every byte is written or a real error occurs.
+    bool writeAll(iovec* parts, int count)
+    {
+        while (count > 0) {
+            ssize_t written = count == 1 ? ::write(m_fd, parts[0].iov_base, parts[0].iov_len) : ::writev(m_fd, parts, count);
+            ++m_syscalls;
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            std::size_t done = static_cast<std::size_t>(written);
+            while (count > 0 && done >= parts[0].iov_len) {
+                done -= parts[0].iov_len;
+                ++parts;
+                --count;
+            }
+            if (count > 0) {
+                parts[0].iov_base = static_cast<char*>(parts[0].iov_base) + done;
+                parts[0].iov_len -= done;
+            }
+        }
+        return true;
+    }
+
+    int m_fd;
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_size;
+    std::size_t m_syscalls = 0;
+};
+
+// An std::ostream over FdOutputBuf: all formatting of std::ostream, none of the stdio synchronization.
+class FdOutputStream : public std::ostream
+{
+public:
+    explicit FdOutputStream(int fd = STDOUT_FILENO, std::size_t bufferSize = FdOutputBuf::kDefaultBufferSize)
+        : std::ostream(nullptr), m_buffer(fd, bufferSize)
+    {
+        rdbuf(&m_buffer);
+    }
+
+    FdOutputBuf& buffer() { return m_buffer; }
+
+private:
+    FdOutputBuf m_buffer;
+};
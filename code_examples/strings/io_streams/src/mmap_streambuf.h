@@ -0,0 +1,301 @@
+#pragma once
+
+#include <cstddef>
+#include <fcntl.h>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Stream buffers over a memory mapped file.
+// std::ifstream copies every block from the kernel into the filebuf buffer, then the stream copies again
+// into the caller's strings. MappedInputBuf maps the whole file and uses the mapping itself as the get
+// area: there is no buffer to refill, underflow() only happens at the end of the file, and nextLine()
+// hands out string_views into the mapping without any copy.
+// Both buffers follow the std::filebuf model: open(), is_open() and close(), a failed open leaves the
+// buffer closed and the stream wrappers set failbit.
+class MappedInputBuf : public std::streambuf
+{
+public:
+    MappedInputBuf() = default;
+
+    explicit MappedInputBuf(const std::string& path)
+    {
+        open(path);
+    }
+
+    ~MappedInputBuf() override
+    {
+        close();
+    }
+
+    MappedInputBuf(const MappedInputBuf&) = delete;
+    MappedInputBuf& operator=(const MappedInputBuf&) = delete;
+
+    bool open(const std::string& path)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info {};
+        bool ok = ::fstat(fd, &info) == 0;
+        std::size_t size = ok ? static_cast<std::size_t>(info.st_size) : 0;
+        if (ok && size > 0) {
+            void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = data != MAP_FAILED;
+            if (ok) {
+                // m_size is only set together with m_data, a failed open leaves both empty
+                m_data = static_cast<char*>(data);
+                m_size = size;
+                // Read ahead aggressively and drop pages behind the reader.
+                ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+
+        m_open = ok;
+        setg(m_data, m_data, m_data + m_size);
+        return ok;
+    }
+
+    bool is_open() const { return m_open; }
+
+    void close()
+    {
+        if (m_data != nullptr)
+            ::munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+        setg(nullptr, nullptr, nullptr);
+    }
+
+    // The whole file.
+    std::string_view view() const { return {m_data, m_size}; }
+
+    // Zero copy alternative to std::getline: the next line without its '\n', pointing into the mapping.
+    // Reads from the same position as the stream.
+    bool nextLine(std::string_view& line)
+    {
+        if (gptr() == egptr())
+            return false;
+        std::string_view rest(gptr(), static_cast<std::size_t>(egptr() - gptr()));
+        std::size_t newline = rest.find('\n');
+        line = rest.substr(0, newline);
+        setg(eback(), gptr() + line.size() + (newline == std::string_view::npos ? 0 : 1), egptr());
+        return true;
+    }
+
+protected:
+    // The get area is the whole file, reaching its end means the end of the input.
+    int_type underflow() override
+    {
+        return gptr() < egptr() ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+    }
+
+    std::streamsize showmanyc() override
+    {
+        return gptr() < egptr() ? egptr() - gptr() : -1;
+    }
+
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+        off_type base = direction == std::ios_base::beg ? 0 : (direction == std::ios_base::cur ? gptr() - eback() : egptr() - eback());
+        return seekpos(pos_type(base + offset), which);
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+    {
+        off_type offset = off_type(position);
+        if (!(which & std::ios_base::in) || offset < 0 || offset > egptr() - eback())
+            return pos_type(off_type(-1));
+        setg(eback(), eback() + offset, egptr());
+        return position;
+    }
+
+private:
+    char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+};
+
+// A file written through a shared mapping. The file grows in place: when the put area is full it is
+// extended with ftruncate and remapped (mremap can move the mapping without copying the pages).
+// close() cuts the file back to the bytes actually written.
+class MappedOutputBuf : public std::streambuf
+{
+public:
+    static constexpr std::size_t kInitialCapacity = 1 << 20;
+
+    MappedOutputBuf() = default;
+
+    explicit MappedOutputBuf(const std::string& path, std::size_t initialCapacity = kInitialCapacity)
+    {
+        open(path, initialCapacity);
+    }
+
+    ~MappedOutputBuf() override
+    {
+        close();
+    }
+
+    MappedOutputBuf(const MappedOutputBuf&) = delete;
+    MappedOutputBuf& operator=(const MappedOutputBuf&) = delete;
+
+    bool open(const std::string& path, std::size_t initialCapacity = kInitialCapacity)
+    {
+        close();
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (m_fd < 0)
+            return false;
+        if (!remap(initialCapacity > 0 ? initialCapacity : kInitialCapacity, 0)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    bool is_open() const { return m_fd >= 0; }
+
+    // Returns false when the file could not be cut to its final size.
+    bool close()
+    {
+        if (m_fd < 0)
+            return true;
+        std::size_t written = size();
+        if (m_data != nullptr)
+            ::munmap(m_data, m_capacity);
+        bool ok = ::ftruncate(m_fd, static_cast<off_t>(written)) == 0;
+        ok = ::close(m_fd) == 0 && ok;
+
+        m_fd = -1;
+        m_data = nullptr;
+        m_capacity = 0;
+        setp(nullptr, nullptr);
+        return ok;
+    }
+
+    // Bytes written so far.
+    std::size_t size() const { return static_cast<std::size_t>(pptr() - pbase()); }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (m_fd < 0 || !remap(m_capacity * 2, size()))
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override
+    {
+        std::size_t needed = size() + static_cast<std::size_t>(count);
+        if (needed > m_capacity) {
+            std::size_t capacity = m_capacity * 2;
+            while (capacity < needed)
+                capacity *= 2;
+            if (m_fd < 0 || !remap(capacity, size()))
+                return 0;
+        }
+        traits_type::copy(pptr(), data, static_cast<std::size_t>(count));
+        pbump_large(static_cast<std::size_t>(count));
+        return count;
+    }
+
+    // The pages already belong to the file, sync only asks the kernel to start writing them back.
+    int sync() override
+    {
+        if (m_data != nullptr && ::msync(m_data, m_capacity, MS_ASYNC) != 0)
+            return -1;
+        return 0;
+    }
+
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+    {
+        // Only tellp() is supported: the current position of the writer.
+        if (offset != 0 || direction != std::ios_base::cur || !(which & std::ios_base::out))
+            return pos_type(off_type(-1));
+        return pos_type(static_cast<off_type>(size()));
+    }
+
+private:
+    // Resizes the file and the mapping to capacity, the put position stays at written.
+    bool remap(std::size_t capacity, std::size_t written)
+    {
+        if (::ftruncate(m_fd, static_cast<off_t>(capacity)) != 0)
+            return false;
+
+        void* data = m_data == nullptr
+            ? ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0)
+            : ::mremap(m_data, m_capacity, capacity, MREMAP_MAYMOVE);
+        if (data == MAP_FAILED)
+            return false;
+
+        m_data = static_cast<char*>(data);
+        m_capacity = capacity;
+        setp(m_data, m_data + m_capacity);
+        pbump_large(written);
+        return true;
+    }
+
+    // pbump takes an int, files can be larger than 2 GB.
+    void pbump_large(std::size_t count)
+    {
+        constexpr std::size_t kStep = 1 << 30;
+        for (; count > kStep; count -= kStep)
+            pbump(static_cast<int>(kStep));
+        pbump(static_cast<int>(count));
+    }
+
+    int m_fd = -1;
+    char* m_data = nullptr;
+    std::size_t m_capacity = 0;
+};
+
+// std::istream reading from a MappedInputBuf, a drop-in replacement for std::ifstream.
+class MappedIfstream : public std::istream
+{
+public:
+    explicit MappedIfstream(const std::string& path)
+        : std::istream(nullptr)
+    {
+        rdbuf(&m_buffer);
+        if (!m_buffer.open(path))
+            setstate(std::ios_base::failbit);
+    }
+
+    MappedInputBuf& buffer() { return m_buffer; }
+
+private:
+    MappedInputBuf m_buffer;
+};
+
+// std::ostream writing into a MappedOutputBuf.
+class MappedOfstream : public std::ostream
+{
+public:
+    explicit MappedOfstream(const std::string& path, std::size_t initialCapacity = MappedOutputBuf::kInitialCapacity)
+        : std::ostream(nullptr)
+    {
+        rdbuf(&m_buffer);
+        if (!m_buffer.open(path, initialCapacity))
+            setstate(std::ios_base::failbit);
+    }
+
+    MappedOutputBuf& buffer() { return m_buffer; }
+
+private:
+    MappedOutputBuf m_buffer;
+};
@@ -0,0 +1,115 @@
+#include "03_custom_formatter_parse.h"
+#include "benchmark.h"
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// The previous std::formatter<Person>: build a temporary string with a nested std::format,
+// then copy it into the output with a second formatting pass.
+struct LegacyPerson : Person {
+    using Person::Person;
+};
+
+template<>
+class std::formatter<LegacyPerson> {
+private:
+    char _presentation = 'n';
+
+public:
+    constexpr auto parse(std::format_parse_context& context) {
+        auto it = context.begin();
+        auto end = context.end();
+        if (it != end && (*it == 'n' || *it == 'L' || *it == 'f' || *it == 'i')) {
+            _presentation = *it;
+            ++it;
+        }
+        return it;
+    }
+
+    auto format(const LegacyPerson& person, std::format_context& context) const {
+        std::string temp_str;
+        switch (_presentation) {
+            case 'n':
+                temp_str = std::format("{} {}", person.getFirstName(), person.getLastName());
+                break;
+            case 'L':
+                temp_str = std::format("{}, {}", person.getLastName(), person.getFirstName());
+                break;
+            case 'f':
+                temp_str = std::format("{} {} (ID: {})", person.getFirstName(), person.getLastName(), person.getId());
+                break;
+            case 'i':
+                temp_str = std::format("{}", person.getId());
+                break;
+        }
+        return std::format_to(context.out(), "{}", temp_str);
+    }
+};
+
+class Benchmark_01_Person_Formatter
+{
+public:
+    void Run()
+    {
+        makeRecords();
+
+        // Every record is appended to one reused string, so only the formatter itself can allocate.
+        printHeader("🚀 Person formatter: 10M records, format_to into a reused std::string");
+        runPresentation("{}", "{}", "{}");
+        runPresentation("{:L}", "{:L}", "{:L}");
+        runPresentation("{:f}", "{:f}", "{:f}");
+        runPresentation("{:i}", "{:i}", "{:i}");
+
+        // The new formatter also supports fill, align and width. The legacy one has no padding support.
+        printRow("{:f>40}, new (stack buffer + nested formatter)", measure(kRecords, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), "{:f>40}", m_people[i % kDistinct]);
+            return takeOutput();
+        }));
+    }
+
+private:
+    static constexpr std::size_t kRecords = 10'000'000;
+    static constexpr std::size_t kDistinct = 1'000;
+
+    // Names long enough to defeat the small string optimization of the legacy temporaries.
+    void makeRecords()
+    {
+        const char* firstNames[] = {"John", "Alexandria", "Bartholomew", "Li"};
+        const char* lastNames[] = {"Doe", "Vandenberghe-Lippens", "Smith", "Montgomery-Featherstonehaugh"};
+        for (std::size_t i = 0; i < kDistinct; ++i) {
+            unsigned long long id = 1'000'000 + i * 7919;
+            m_people.emplace_back(id, firstNames[i % 4], lastNames[(i / 4) % 4]);
+            m_legacyPeople.emplace_back(id, firstNames[i % 4], lastNames[(i / 4) % 4]);
+        }
+        m_output.reserve(1024);
+    }
+
+    std::size_t takeOutput()
+    {
+        std::size_t size = m_output.size();
+        m_output.clear();
+        return size;
+    }
+
+    // The same spec is passed twice because a std::format_string is checked at compile time for one argument type.
+    void runPresentation(std::string_view spec, std::format_string<const LegacyPerson&> legacyFmt, std::format_string<const Person&> fmt)
+    {
+        BenchmarkResult legacy = measure(kRecords, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), legacyFmt, std::as_const(m_legacyPeople[i % kDistinct]));
+            return takeOutput();
+        });
+        BenchmarkResult current = measure(kRecords, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), fmt, std::as_const(m_people[i % kDistinct]));
+            return takeOutput();
+        });
+
+        printRow(std::format("{}, legacy (temporary string)", spec), legacy);
+        printRow(std::format("{}, new (direct write)", spec), current);
+    }
+
+    std::vector<Person> m_people;
+    std::vector<LegacyPerson> m_legacyPeople;
+    std::string m_output;
+};
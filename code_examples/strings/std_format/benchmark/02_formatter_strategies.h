@@ -0,0 +1,109 @@
+#include "02_custom_formatter.h"
+#include "benchmark.h"
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Point from 02_custom_formatter.h formats into a temporary std::string and delegates to formatter<std::string>.
+// The types below are the same two ints, formatted with the other strategies.
+
+// Strategy 2: format_to straight into the output iterator of the context.
+struct DirectPoint {
+    int x, y;
+};
+
+template <>
+struct std::formatter<DirectPoint> {
+    constexpr auto parse(std::format_parse_context& ctx) { return ctx.begin(); }
+
+    auto format(DirectPoint p, std::format_context& ctx) const {
+        return std::format_to(ctx.out(), "({}, {})", p.x, p.y);
+    }
+};
+
+// Strategy 3: the stream operator of Point in io_streams/src/01_cout.h.
+struct StreamPoint {
+    int x, y;
+};
+
+std::ostream& operator<<(std::ostream& os, const StreamPoint& p) {
+    os << "(" << p.x << ", " << p.y << ")";
+    return os;
+}
+
+class Benchmark_02_Formatter_Strategies
+{
+public:
+    Benchmark_02_Formatter_Strategies()
+    {
+        m_output.reserve(64);
+    }
+
+    void Run()
+    {
+        printHeader("🚀 Formatter strategies: 10M points");
+
+        // std::format returns a new std::string every call.
+        printRow("std::format, temporary string + formatter<string>", measure(kIterations, [&](std::size_t i) {
+            return std::format("{}", Point{static_cast<int>(i), 20}).size();
+        }));
+        printRow("std::format, format_to(ctx.out())", measure(kIterations, [&](std::size_t i) {
+            return std::format("{}", DirectPoint{static_cast<int>(i), 20}).size();
+        }));
+
+        // format_to into a string that keeps its capacity: only the formatter itself can allocate.
+        printRow("format_to reused string, temporary string", measure(kIterations, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), "{}", Point{static_cast<int>(i), 20});
+            return takeOutput();
+        }));
+        printRow("format_to reused string, format_to(ctx.out())", measure(kIterations, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), "{}", DirectPoint{static_cast<int>(i), 20});
+            return takeOutput();
+        }));
+
+        // format_to_n into a stack buffer: no std::string at all, output is truncated at the buffer size.
+        printRow("format_to_n stack buffer, format_to(ctx.out())", measure(kIterations, [&](std::size_t i) {
+            char buffer[64];
+            auto result = std::format_to_n(buffer, sizeof(buffer), "{}", DirectPoint{static_cast<int>(i), 20});
+            return static_cast<std::size_t>(result.size);
+        }));
+
+        // vformat with a format string chosen at runtime and kept around: no compile-time checking,
+        // the string is parsed on every call.
+        std::string_view cachedFormat = m_runtimeFormat;
+        printRow("std::vformat, cached runtime format string", measure(kIterations, [&](std::size_t i) {
+            DirectPoint p{static_cast<int>(i), 20};
+            return std::vformat(cachedFormat, std::make_format_args(p)).size();
+        }));
+        printRow("std::vformat_to reused string, cached format", measure(kIterations, [&](std::size_t i) {
+            DirectPoint p{static_cast<int>(i), 20};
+            std::vformat_to(std::back_inserter(m_output), cachedFormat, std::make_format_args(p));
+            return takeOutput();
+        }));
+
+        // operator<< into an ostringstream that is rewound, not recreated: sentry and locale work on every <<.
+        printRow("ostream operator<<, reused ostringstream", measure(kIterations, [&](std::size_t i) {
+            m_stream.seekp(0);
+            m_stream << StreamPoint{static_cast<int>(i), 20};
+            return static_cast<std::size_t>(m_stream.tellp());
+        }));
+    }
+
+private:
+    static constexpr std::size_t kIterations = 10'000'000;
+
+    std::size_t takeOutput()
+    {
+        std::size_t size = m_output.size();
+        m_output.clear();
+        return size;
+    }
+
+    std::string m_output;
+    std::string m_runtimeFormat = "{}";
+    std::ostringstream m_stream;
+};
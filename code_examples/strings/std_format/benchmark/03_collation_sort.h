@@ -0,0 +1,97 @@
+#include "collation_sort.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <locale>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sorting 1M words in German collation order: a comparator calling collate::compare against
+// precomputed collate::transform keys, sorted by comparison, by radix and on several threads.
+class Benchmark_03_Collation_Sort
+{
+public:
+    void Run()
+    {
+        std::locale de_locale;
+        try {
+            de_locale = std::locale("de_DE.UTF-8");
+        } catch (const std::runtime_error& e) {
+            std::cout << std::format("\n🚀 Collation sort skipped: {}\n", e.what());
+            return;
+        }
+
+        makeWords();
+        unsigned threads = std::max(4u, std::thread::hardware_concurrency());
+
+        std::cout << std::format("\n🚀 Collation sort: {} words, de_DE.UTF-8\n", kWords);
+        std::cout << std::format("{:<52} {:>10} {:>12}\n", "case", "ms", "allocs");
+        std::cout << std::string(76, '-') << '\n';
+
+        const auto& facet = std::use_facet<std::collate<char>>(de_locale);
+        auto less = [&](const std::string& a, const std::string& b) {
+            return facet.compare(a.data(), a.data() + a.size(), b.data(), b.data() + b.size()) < 0;
+        };
+
+        run("std::sort, collate::compare comparator", less, [&](std::vector<std::string>& words) {
+            std::sort(words.begin(), words.end(), less);
+        });
+
+        run("sort keys, std::sort", less, [&](std::vector<std::string>& words) {
+            collation::sort(words, de_locale);
+        });
+        run("sort keys, MSD radix sort", less, [&](std::vector<std::string>& words) {
+            collation::sort(words, de_locale, {.algorithm = collation::Algorithm::Radix});
+        });
+        run(std::format("sort keys, std::sort, {} threads", threads), less, [&](std::vector<std::string>& words) {
+            collation::sort(words, de_locale, {.threads = threads});
+        });
+        run(std::format("sort keys, MSD radix sort, {} threads", threads), less, [&](std::vector<std::string>& words) {
+            collation::sort(words, de_locale, {.algorithm = collation::Algorithm::Radix, .threads = threads});
+        });
+    }
+
+private:
+    static constexpr std::size_t kWords = 1'000'000;
+
+    // Random words from a German alphabet, with umlauts and ß so the locale rules matter.
+    void makeWords()
+    {
+        const std::vector<std::string> letters = {
+            "a", "b", "c", "d", "e", "f", "g", "h", "i", "k", "l", "m", "n", "o", "r", "s", "t", "u", "z",
+            "A", "B", "S", "Z", "ä", "ö", "ü", "Ä", "Ö", "Ü", "ß"};
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<std::size_t> length(3, 12);
+        std::uniform_int_distribution<std::size_t> letter(0, letters.size() - 1);
+
+        m_words.resize(kWords);
+        for (std::string& word : m_words)
+            for (std::size_t n = length(rng); n > 0; --n)
+                word += letters[letter(rng)];
+    }
+
+    // Sorts a fresh copy of the words and checks the result against the collate::compare order, outside the timing.
+    template <typename Less, typename Sort>
+    void run(const std::string& name, const Less& less, Sort&& sort)
+    {
+        std::vector<std::string> words = m_words;
+
+        std::size_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        sort(words);
+        auto stop = std::chrono::steady_clock::now();
+        std::size_t allocations = g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+        const char* check = std::is_sorted(words.begin(), words.end(), less) ? "" : "  (not sorted!)";
+
+        double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+        std::cout << std::format("{:<52} {:>10.2f} {:>12}{}\n", name, ms, allocations, check);
+    }
+
+    std::vector<std::string> m_words;
+};
@@ -0,0 +1,87 @@
+#include "timestamp_formatter.h"
+#include "benchmark.h"
+#include <array>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+// Log timestamps: 10M time points 100us apart, round robin over three zones.
+class Benchmark_04_Timestamp_Formatter
+{
+public:
+    void Run()
+    {
+        using namespace std::chrono;
+        m_start = floor<seconds>(system_clock::now());
+
+        if (!verify()) {
+            std::cout << "\n🚀 Timestamp formatter: output differs from std::format, skipped\n";
+            return;
+        }
+
+        printHeader("🚀 Timestamp formatter: 10M log timestamps, 3 zones");
+
+        printRow("std::format, locate_zone per call", measure(kTimestamps, [&](std::size_t i) {
+            zoned_time zoned{locate_zone(kZoneNames[i % kZones]), timeAt(i)};
+            return std::format("{:%Y-%m-%d %H:%M:%S}", zoned).size();
+        }));
+
+        std::array<const time_zone*, kZones> zones;
+        for (std::size_t z = 0; z < kZones; ++z)
+            zones[z] = locate_zone(kZoneNames[z]);
+
+        printRow("std::format, cached zone pointer", measure(kTimestamps, [&](std::size_t i) {
+            zoned_time zoned{zones[i % kZones], timeAt(i)};
+            return std::format("{:%Y-%m-%d %H:%M:%S}", zoned).size();
+        }));
+        printRow("std::format_to reused string, cached zone", measure(kTimestamps, [&](std::size_t i) {
+            zoned_time zoned{zones[i % kZones], timeAt(i)};
+            std::format_to(std::back_inserter(m_output), "{:%Y-%m-%d %H:%M:%S}", zoned);
+            std::size_t size = m_output.size();
+            m_output.clear();
+            return size;
+        }));
+
+        timestamp::ZoneCache cache;
+        printRow("ZonedFormatter, ZoneCache lookup by name", measure(kTimestamps, [&](std::size_t i) {
+            char buffer[timestamp::ZonedFormatter::kSize];
+            return cache.get(kZoneNames[i % kZones]).format(timeAt(i), buffer);
+        }));
+
+        std::array<timestamp::ZonedFormatter, kZones> formatters{
+            timestamp::ZonedFormatter(zones[0]), timestamp::ZonedFormatter(zones[1]), timestamp::ZonedFormatter(zones[2])};
+        printRow("ZonedFormatter, caller buffer", measure(kTimestamps, [&](std::size_t i) {
+            char buffer[timestamp::ZonedFormatter::kSize];
+            return formatters[i % kZones].format(timeAt(i), buffer);
+        }));
+    }
+
+private:
+    static constexpr std::size_t kTimestamps = 10'000'000;
+    static constexpr std::size_t kZones = 3;
+    static constexpr std::array<std::string_view, kZones> kZoneNames = {"Europe/Brussels", "America/New_York", "Asia/Tokyo"};
+
+    std::chrono::sys_seconds timeAt(std::size_t i) const
+    {
+        return std::chrono::floor<std::chrono::seconds>(m_start + std::chrono::microseconds(100 * i));
+    }
+
+    // The cached formatter has to produce exactly what std::format does.
+    bool verify() const
+    {
+        timestamp::ZoneCache cache;
+        for (std::size_t i = 0; i < kTimestamps; i += 997) {
+            std::string_view name = kZoneNames[i % kZones];
+            std::string expected = std::format("{:%Y-%m-%d %H:%M:%S}", std::chrono::zoned_time{name, timeAt(i)});
+            if (cache.get(name).toString(timeAt(i)) != expected)
+                return false;
+        }
+        return true;
+    }
+
+    std::chrono::sys_seconds m_start;
+    std::string m_output;
+};
@@ -0,0 +1,98 @@
+#include "number_formatter.h"
+#include "benchmark.h"
+#include <format>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Locale-aware integers, doubles and money: std::format(loc, "{:L}"), an imbued stringstream per value
+// (as in 04_locales.h), a reused imbued stream and NumberFormatter writing into a stack buffer.
+class Benchmark_05_Number_Formatter
+{
+public:
+    void Run()
+    {
+        std::locale de_locale;
+        try {
+            de_locale = std::locale("de_DE.UTF-8");
+        } catch (const std::runtime_error& e) {
+            std::cout << std::format("\n🚀 Number formatter skipped: {}\n", e.what());
+            return;
+        }
+        localized::NumberFormatter formatter(de_locale);
+
+        printHeader("🚀 Locale number formatting: 10M values, de_DE.UTF-8");
+
+        printRow("integer, std::format(loc, {:L})", measure(kValues, [&](std::size_t i) {
+            return std::format(de_locale, "{:L}", integerAt(i)).size();
+        }));
+        printRow("integer, format_to(loc) reused string", measure(kValues, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), de_locale, "{:L}", integerAt(i));
+            return takeOutput();
+        }));
+        printRow("integer, imbued stringstream per value", measure(kValues, [&](std::size_t i) {
+            std::stringstream ss;
+            ss.imbue(de_locale);
+            ss << integerAt(i);
+            return ss.str().size();
+        }));
+        printRow("integer, NumberFormatter stack buffer", measure(kValues, [&](std::size_t i) {
+            char buffer[64];
+            return static_cast<std::size_t>(formatter.format(buffer, buffer + sizeof(buffer), integerAt(i)).ptr - buffer);
+        }));
+
+        printRow("double, std::format(loc, {:.2Lf})", measure(kValues, [&](std::size_t i) {
+            return std::format(de_locale, "{:.2Lf}", doubleAt(i)).size();
+        }));
+        printRow("double, imbued stringstream per value", measure(kValues, [&](std::size_t i) {
+            std::stringstream ss;
+            ss.imbue(de_locale);
+            ss << std::fixed << std::setprecision(2) << doubleAt(i);
+            return ss.str().size();
+        }));
+        printRow("double, NumberFormatter stack buffer", measure(kValues, [&](std::size_t i) {
+            char buffer[64];
+            return static_cast<std::size_t>(formatter.format(buffer, buffer + sizeof(buffer), doubleAt(i), 2).ptr - buffer);
+        }));
+
+        printRow("money, put_money imbued stringstream per value", measure(kValues, [&](std::size_t i) {
+            std::stringstream ss;
+            ss.imbue(de_locale);
+            ss << std::showbase << std::put_money(moneyAt(i), true);
+            return ss.str().size();
+        }));
+        std::ostringstream reused;
+        reused.imbue(de_locale);
+        reused << std::showbase;
+        printRow("money, put_money reused ostringstream", measure(kValues, [&](std::size_t i) {
+            reused.seekp(0);
+            reused << std::put_money(moneyAt(i), true);
+            return static_cast<std::size_t>(reused.tellp());
+        }));
+        printRow("money, NumberFormatter stack buffer", measure(kValues, [&](std::size_t i) {
+            char buffer[64];
+            return static_cast<std::size_t>(formatter.formatMoney(buffer, buffer + sizeof(buffer), moneyAt(i)).ptr - buffer);
+        }));
+    }
+
+private:
+    static constexpr std::size_t kValues = 10'000'000;
+
+    // Values spread over several magnitudes so grouping inserts between zero and four separators.
+    static long long integerAt(std::size_t i) { return static_cast<long long>(i * 2654435761ULL % 10'000'000'000'000ULL) >> (i % 40); }
+    static double doubleAt(std::size_t i) { return static_cast<double>(integerAt(i)) / 100.0; }
+    static long double moneyAt(std::size_t i) { return static_cast<long double>(integerAt(i) % 1'000'000'000); }
+
+    std::size_t takeOutput()
+    {
+        std::size_t size = m_output.size();
+        m_output.clear();
+        return size;
+    }
+
+    std::string m_output;
+};
@@ -0,0 +1,89 @@
+#include "compiled_format.h"
+#include "benchmark.h"
+#include <array>
+#include <format>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+// Typical log lines: std::format and std::format_to, which parse the format string on every call,
+// against compiled::format with the string split into segments at compile time.
+class Benchmark_06_Compiled_Format
+{
+public:
+    void Run()
+    {
+        if (!verify()) {
+            std::cout << "\n🚀 Compiled format: output differs from std::format, skipped\n";
+            return;
+        }
+
+        printHeader("🚀 Compiled format strings: 10M log lines, \"{}\" fields only");
+
+        printRow("std::format", measure(kLines, [&](std::size_t i) {
+            return std::format("[{}] worker {} processed {} items in {} ms", levelAt(i), workerAt(i), i, msAt(i)).size();
+        }));
+        printRow("std::format_to reused string", measure(kLines, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), "[{}] worker {} processed {} items in {} ms", levelAt(i), workerAt(i), i, msAt(i));
+            return takeOutput();
+        }));
+        printRow("std::format_to stack buffer", measure(kLines, [&](std::size_t i) {
+            char buffer[256];
+            return static_cast<std::size_t>(std::format_to(buffer, "[{}] worker {} processed {} items in {} ms", levelAt(i), workerAt(i), i, msAt(i)) - buffer);
+        }));
+        printRow("compiled::format", measure(kLines, [&](std::size_t i) {
+            return compiled::format<"[{}] worker {} processed {} items in {} ms">(levelAt(i), workerAt(i), i, msAt(i)).size();
+        }));
+        printRow("compiled::format_append reused string", measure(kLines, [&](std::size_t i) {
+            compiled::format_append<"[{}] worker {} processed {} items in {} ms">(m_output, levelAt(i), workerAt(i), i, msAt(i));
+            return takeOutput();
+        }));
+        printRow("compiled::format_to stack buffer", measure(kLines, [&](std::size_t i) {
+            char buffer[256];
+            return static_cast<std::size_t>(compiled::format_to<"[{}] worker {} processed {} items in {} ms">(buffer, levelAt(i), workerAt(i), i, msAt(i)) - buffer);
+        }));
+
+        // Width, alignment, base and precision are parsed at compile time as well.
+        printHeader("🚀 Compiled format strings: 10M log lines with format specs");
+
+        printRow("std::format_to reused string", measure(kLines, [&](std::size_t i) {
+            std::format_to(std::back_inserter(m_output), "{:<7} worker {:>3} item {:#x} took {:.2f} ms", levelAt(i), workerAt(i), i, msAt(i));
+            return takeOutput();
+        }));
+        printRow("compiled::format_append reused string", measure(kLines, [&](std::size_t i) {
+            compiled::format_append<"{:<7} worker {:>3} item {:#x} took {:.2f} ms">(m_output, levelAt(i), workerAt(i), i, msAt(i));
+            return takeOutput();
+        }));
+    }
+
+private:
+    static constexpr std::size_t kLines = 10'000'000;
+    static constexpr std::array<std::string_view, 4> kLevels{"DEBUG", "INFO", "WARNING", "ERROR"};
+
+    static std::string_view levelAt(std::size_t i) { return kLevels[i % kLevels.size()]; }
+    static int workerAt(std::size_t i) { return static_cast<int>(i % 16); }
+    static double msAt(std::size_t i) { return static_cast<double>(i % 100'000) / 8.0; }
+
+    bool verify()
+    {
+        for (std::size_t i = 0; i < 10'000; ++i) {
+            std::string expected = std::format("[{}] worker {} processed {} items in {} ms", levelAt(i), workerAt(i), i, msAt(i));
+            if (compiled::format<"[{}] worker {} processed {} items in {} ms">(levelAt(i), workerAt(i), i, msAt(i)) != expected)
+                return false;
+            expected = std::format("{:<7} worker {:>3} item {:#x} took {:.2f} ms", levelAt(i), workerAt(i), i, msAt(i));
+            if (compiled::format<"{:<7} worker {:>3} item {:#x} took {:.2f} ms">(levelAt(i), workerAt(i), i, msAt(i)) != expected)
+                return false;
+        }
+        return true;
+    }
+
+    std::size_t takeOutput()
+    {
+        std::size_t size = m_output.size();
+        m_output.clear();
+        return size;
+    }
+
+    std::string m_output;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Incremented by the replacement operator new in main.cpp.
+inline std::atomic<std::size_t> g_allocationCount{0};
+
+struct BenchmarkResult {
+    double nsPerOp = 0.0;
+    double allocationsPerOp = 0.0;
+};
+
+// Calls func(i) for every iteration. func returns a size (e.g. the number of characters written)
+// which is summed, so the compiler cannot throw the formatting away.
+template <typename Func>
+BenchmarkResult measure(std::size_t iterations, Func&& func)
+{
+    static volatile std::size_t sink = 0;
+    std::size_t total = 0;
+
+    std::size_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+        total += func(i);
+    auto stop = std::chrono::steady_clock::now();
+    std::size_t allocations = g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+    sink = sink + total;
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    return {ns / iterations, static_cast<double>(allocations) / iterations};
+}
+
+inline void printHeader(std::string_view title)
+{
+    std::cout << std::format("\n{}\n", title);
+    std::cout << std::format("{:<52} {:>10} {:>12}\n", "case", "ns/op", "allocs/op");
+    std::cout << std::string(76, '-') << '\n';
+}
+
+inline void printRow(std::string_view name, const BenchmarkResult& result)
+{
+    std::cout << std::format("{:<52} {:>10.2f} {:>12.3f}\n", name, result.nsPerOp, result.allocationsPerOp);
+}
@@ -0,0 +1,69 @@
+#include "01_person_formatter.h"
+#include "02_formatter_strategies.h"
+#include "03_collation_sort.h"
+#include "04_timestamp_formatter.h"
+#include "05_number_formatter.h"
+#include "06_compiled_format.h"
+#include <cstdlib>
+#include <format>
+#include <new>
+
+// Count every heap allocation of the process, the benchmarks report them per operation.
+void* operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+    int benchmarkId = 0; // 0 runs all of them
+
+    if (argc > 1)
+        benchmarkId = std::atoi(argv[1]);
+
+    if (benchmarkId == 0 || benchmarkId == 1)
+    {
+        Benchmark_01_Person_Formatter benchmark1;
+        benchmark1.Run();
+    }
+    if (benchmarkId == 0 || benchmarkId == 2)
+    {
+        Benchmark_02_Formatter_Strategies benchmark2;
+        benchmark2.Run();
+    }
+    if (benchmarkId == 0 || benchmarkId == 3)
+    {
+        Benchmark_03_Collation_Sort benchmark3;
+        benchmark3.Run();
+    }
+    if (benchmarkId == 0 || benchmarkId == 4)
+    {
+        Benchmark_04_Timestamp_Formatter benchmark4;
+        benchmark4.Run();
+    }
+    if (benchmarkId == 0 || benchmarkId == 5)
+    {
+        Benchmark_05_Number_Formatter benchmark5;
+        benchmark5.Run();
+    }
+    if (benchmarkId == 0 || benchmarkId == 6)
+    {
+        Benchmark_06_Compiled_Format benchmark6;
+        benchmark6.Run();
+    }
+
+    return 0;
+}
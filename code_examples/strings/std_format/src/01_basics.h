@@ -1,3 +1,4 @@
+#include "compiled_format.h"
 #include <format>
 #include <iostream>
 #include <string>
@@ -12,6 +13,7 @@ public:
         integer_formatting();
         floating_point_formatting();
         string_and_alignment();
+        compiled_format_strings();
     }
 
 private:
@@ -64,4 +66,18 @@ private:
         std::cout << std::format("Center aligned (width 10): '{:^10}'\n", text);
         std::cout << std::format("Padded with '*': '{:*<10}'\n\n", text);
     }
+
+    // Parsing the format string at compile time instead of on every call.
+    void compiled_format_strings()
+    {
+        std::cout << "🚀 Exercise 6: Compiled Format Strings\n";
+        // Question: std::format already checks the format string at compile time, what is left to do at run time?
+        // std::format parses the string again on every call. compiled::format splits it into literal and
+        // argument segments during compilation, the call only appends (see benchmark 6).
+        std::string level = "INFO";
+        std::cout << compiled::format<"[{:<7}] worker {} processed {} items in {:.2f} ms\n">(level, 3, 1250, 12.3456);
+        std::string line;
+        compiled::format_append<"{:>8}|{:#x}|{}\n\n">(line, "right", 255, true);
+        std::cout << line;
+    }
 };
\ No newline at end of file
@@ -1,6 +1,9 @@
+#include <algorithm> // For std::ranges::copy
+#include <charconv>  // For std::to_chars
 #include <format>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 class Person {
 public:
@@ -17,12 +20,65 @@ private:
 };
 
 // Specializing std::formatter for our Person class.
+// The spec is an optional presentation character followed by the standard fill, align and width,
+// e.g. {:L}, {:f>30} or {:*^20}.
 template<>
 class std::formatter<Person> {
 private:
     // This member variable will store the custom specifier we parse.
-    char _presentation = 'n'; 
-    
+    char _presentation = 'n';
+
+    // A nested formatter handles the standard part of the spec (fill, align, width).
+    std::formatter<std::string_view> _padding_formatter;
+    bool _has_padding = false;
+
+    // Every presentation is produced piece by piece through append(std::string_view),
+    // no intermediate string is built.
+    template <typename Append>
+    void write(const Person& person, Append&& append) const {
+        char id_buffer[20]; // enough for any unsigned long long
+        auto id_end = std::to_chars(id_buffer, id_buffer + sizeof(id_buffer), person.getId()).ptr;
+        std::string_view id(id_buffer, id_end - id_buffer);
+
+        switch (_presentation) {
+            case 'n':
+                append(person.getFirstName());
+                append(" ");
+                append(person.getLastName());
+                break;
+            case 'L':
+                append(person.getLastName());
+                append(", ");
+                append(person.getFirstName());
+                break;
+            case 'f':
+                append(person.getFirstName());
+                append(" ");
+                append(person.getLastName());
+                append(" (ID: ");
+                append(id);
+                append(")");
+                break;
+            case 'i':
+                append(id);
+                break;
+        }
+    }
+
+    std::size_t text_size(const Person& person) const {
+        std::size_t digits = 1;
+        for (auto id = person.getId(); id >= 10; id /= 10)
+            ++digits;
+
+        std::size_t names = person.getFirstName().size() + person.getLastName().size();
+        switch (_presentation) {
+            case 'n': return names + 1;
+            case 'L': return names + 2;
+            case 'f': return names + 1 + 6 + digits + 1;
+            default: return digits;
+        }
+    }
+
 public:
     // The parse method is responsible for consuming custom format specifiers.
     // The return value points to the character after the last one parsed by our code.
@@ -35,30 +91,42 @@ public:
             _presentation = *it;
             ++it;
         }
+
+        // Anything left is a standard spec: hand it to the nested formatter.
+        if (it != end && *it != '}') {
+            _has_padding = true;
+            context.advance_to(it);
+            return _padding_formatter.parse(context);
+        }
         return it;
     }
-    
+
     // The format method uses the state parsed by the parse method to produce the output.
     auto format(const Person& person, std::format_context& context) const {
-        std::string temp_str;
-        switch (_presentation) {
-            case 'n':
-                temp_str = std::format("{} {}", person.getFirstName(), person.getLastName());
-                break;
-            case 'L':
-                temp_str = std::format("{}, {}", person.getLastName(), person.getFirstName());
-                break;
-            case 'f':
-                temp_str = std::format("{} {} (ID: {})", person.getFirstName(), person.getLastName(), person.getId());
-                break;
-            case 'i':
-                temp_str = std::format("{}", person.getId());
-                break;
+        // Without fill or width every field goes straight into the output iterator provided by the context.
+        // Each field is copied as a whole range instead of one character at a time.
+        if (!_has_padding) {
+            write(person, [&](std::string_view text) {
+                context.advance_to(std::ranges::copy(text, context.out()).out);
+            });
+            return context.out();
         }
-        
-        // We can't simply return a new string. We must write to the output iterator
-        // provided by the context.
-        return std::format_to(context.out(), "{}", temp_str);
+
+        // Padding needs the whole text at once: write it into a stack buffer, only unusually long names need the heap.
+        char buffer[256];
+        std::string large;
+        char* text = buffer;
+        std::size_t size = text_size(person);
+        if (size > sizeof(buffer)) {
+            large.resize(size);
+            text = large.data();
+        }
+
+        char* text_end = text;
+        write(person, [&](std::string_view piece) {
+            text_end = std::ranges::copy(piece, text_end).out;
+        });
+        return _padding_formatter.format(std::string_view(text, text_end), context);
     }
 };
 
@@ -76,5 +144,10 @@ public:
         std::cout << std::format("Last name first: {:L}\n", p);
         std::cout << std::format("Full details: {:f}\n", p);
         std::cout << std::format("ID only: {:i}\n", p);
+
+        std::cout << "\n🚀 Exercise 3: Custom Specifiers with Fill, Align and Width\n";
+        std::cout << std::format("Right aligned: '{:n>15}'\n", p);
+        std::cout << std::format("Centered ID:   '{:i*^10}'\n", p);
+        std::cout << std::format("Padded:        '{:<15}'\n", p);
     }
 };
\ No newline at end of file
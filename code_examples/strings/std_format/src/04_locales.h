@@ -6,6 +6,9 @@
 #include <stdexcept> // For std::runtime_error
 #include <iomanip>   // For std::put_money
 #include <algorithm> // For std::sort
+#include "collation_sort.h"
+#include "number_formatter.h"
+#include "timestamp_formatter.h"
 
 class Program_04_Locales
 {
@@ -52,6 +55,12 @@ private:
         std::cout << std::format(us_locale, "US locale:      {:L}\n", big_number);
         std::cout << std::format(de_locale, "German locale:  {:L}\n", big_number);
         std::cout << std::format(fr_locale, "French locale:  {:L}\n", big_number);
+
+        // NumberFormatter reads the separators from the facet once and then writes into a stack buffer.
+        localized::NumberFormatter de_formatter(de_locale);
+        char buffer[64];
+        auto result = de_formatter.format(buffer, buffer + sizeof(buffer), big_number);
+        std::cout << "German cached:  " << std::string_view(buffer, result.ptr) << "\n";
         std::cout << "\n";
     }
 
@@ -76,6 +85,13 @@ private:
 
         std::cout << "US (USD): " << format_currency(money_value, us_locale) << "\n";
         std::cout << "DE (EUR): " << format_currency(money_value, de_locale) << "\n";
+
+        // The same amounts without a stream: moneypunct is read once per formatter.
+        localized::NumberFormatter us_formatter(us_locale);
+        localized::NumberFormatter de_formatter(de_locale);
+        char buffer[64];
+        std::cout << "US (cached): " << std::string_view(buffer, us_formatter.formatMoney(buffer, buffer + sizeof(buffer), money_value * 100).ptr) << "\n";
+        std::cout << "DE (cached): " << std::string_view(buffer, de_formatter.formatMoney(buffer, buffer + sizeof(buffer), money_value * 100).ptr) << "\n";
         std::cout << "\n";
     }
 
@@ -129,6 +145,16 @@ private:
             return collate_facet.compare(a.data(), a.data() + a.size(), b.data(), b.data() + b.size()) < 0;
         };
         print_sorted("German", german_compare);
+
+        // 3. German locale sort with precomputed keys
+        // collate::transform computes each key once, compare() above redoes the locale work on every comparison.
+        std::vector<std::string> keyed_words = words;
+        collation::sort(keyed_words, de_locale);
+        std::cout << "German (sort keys) order: ";
+        for (const auto& word : keyed_words) {
+            std::cout << word << " ";
+        }
+        std::cout << "\n";
         std::cout << "\n";
     }
 
@@ -157,6 +183,10 @@ private:
                 std::string location = tz_name;
                 std::string us_full_date = std::format(us_locale, "{0:%A}, {0:%B %d}, {0:%Y} at {0:%I:%M:%S %p}", zoned);
                 std::string us_time_zone = std::format("Time Zone: {0:%Z} (UTC{0:%z})", zoned);
+                // Same local time from the cached formatter, written into a stack buffer.
+                char timestamp_buffer[timestamp::ZonedFormatter::kSize];
+                timestamp::ZonedFormatter timestamp_formatter(time_zone_ptr);
+                std::string_view local_timestamp(timestamp_buffer, timestamp_formatter.format(universal_time, timestamp_buffer));
                 // This does not work?
                 std::string fr_full_date = std::format(fr_locale, "{0:%A} {0:%e} {0:%B} {0:%Y} à {0:%T}", zoned);
 
@@ -177,6 +207,7 @@ private:
                 std::cout << "----------------------------------------\n";
                 std::cout << std::format("  Location: {} {}\n", location, us_time_zone);
                 std::cout << std::format("  (en_US)   {}\n", us_full_date);
+                std::cout << std::format("  (cached)  {}\n", local_timestamp);
                 std::cout << std::format("  (fr_FR)   {}\n", fr_full_date);
                 std::cout << std::format("  (fr_FR) (ss)  {}\n", fr_full_date_ss);
             }
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <locale>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Locale-aware sorting with precomputed sort keys.
+// Sorting with a comparator that calls std::collate::compare does the expensive locale comparison
+// O(n log n) times. std::collate::transform turns a string into a sort key once: comparing two keys
+// byte by byte gives the same order as compare() on the original strings. The keys are sorted, then
+// the original strings are put in that order.
+namespace collation
+{
+    enum class Algorithm {
+        Comparison, // std::sort on the keys
+        Radix,      // MSD radix sort on the key bytes
+    };
+
+    struct Options {
+        Algorithm algorithm = Algorithm::Comparison;
+        unsigned threads = 1; // > 1 computes keys and sorts chunks in parallel, then merges them
+    };
+
+    namespace detail
+    {
+        struct Entry {
+            std::string key;
+            std::size_t index; // position of the original string
+        };
+
+        // std::string compares like unsigned char, which is the order collate::transform keys are defined in.
+        inline bool keyLess(const Entry& a, const Entry& b) { return a.key < b.key; }
+
+        // Byte at the given depth, 0 when the key is shorter (a shorter prefix sorts first).
+        inline unsigned bucketOf(const Entry& entry, std::size_t depth)
+        {
+            return depth < entry.key.size() ? static_cast<unsigned char>(entry.key[depth]) + 1u : 0u;
+        }
+
+        // Most-significant-digit radix sort: distribute on one byte, then recurse into each bucket on the next byte.
+        inline void radixSort(Entry* first, Entry* last, std::size_t depth, std::vector<Entry>& scratch)
+        {
+            constexpr std::ptrdiff_t kSmallRange = 64;
+            constexpr unsigned kBuckets = 257;
+
+            if (last - first <= kSmallRange) {
+                std::sort(first, last, keyLess);
+                return;
+            }
+
+            std::size_t counts[kBuckets + 1] = {};
+            for (Entry* it = first; it != last; ++it)
+                ++counts[bucketOf(*it, depth) + 1];
+            for (unsigned b = 0; b < kBuckets; ++b)
+                counts[b + 1] += counts[b];
+
+            // counts[b] is now the start of bucket b, move every entry into place through the scratch buffer
+            std::size_t starts[kBuckets + 1];
+            std::copy(std::begin(counts), std::end(counts), starts);
+            scratch.resize(static_cast<std::size_t>(last - first));
+            for (Entry* it = first; it != last; ++it)
+                scratch[counts[bucketOf(*it, depth)]++] = std::move(*it);
+            std::move(scratch.begin(), scratch.end(), first);
+
+            // bucket 0 holds keys that ended at this depth, they are all equal
+            for (unsigned b = 1; b < kBuckets; ++b)
+                if (starts[b + 1] - starts[b] > 1)
+                    radixSort(first + starts[b], first + starts[b + 1], depth + 1, scratch);
+        }
+
+        inline void sortEntries(Entry* first, Entry* last, Algorithm algorithm)
+        {
+            if (algorithm == Algorithm::Radix) {
+                std::vector<Entry> scratch;
+                radixSort(first, last, 0, scratch);
+            } else {
+                std::sort(first, last, keyLess);
+            }
+        }
+    }
+
+    inline std::string sortKey(const std::collate<char>& facet, const std::string& text)
+    {
+        return facet.transform(text.data(), text.data() + text.size());
+    }
+
+    // Sorts words in the collation order of the locale.
+    inline void sort(std::vector<std::string>& words, const std::locale& locale, Options options = {})
+    {
+        const auto& facet = std::use_facet<std::collate<char>>(locale);
+        const std::size_t count = words.size();
+        std::vector<detail::Entry> entries(count);
+
+        // Split the work into one contiguous chunk per thread.
+        unsigned threads = std::max(1u, std::min<unsigned>(options.threads, static_cast<unsigned>(count / 1024 + 1)));
+        std::vector<std::size_t> bounds(threads + 1);
+        for (unsigned t = 0; t <= threads; ++t)
+            bounds[t] = count * t / threads;
+
+        // 1. compute every key exactly once, 2. sort each chunk on its keys
+        auto processChunk = [&](unsigned t) {
+            for (std::size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+                entries[i] = {sortKey(facet, words[i]), i};
+            detail::sortEntries(entries.data() + bounds[t], entries.data() + bounds[t + 1], options.algorithm);
+        };
+
+        if (threads == 1) {
+            processChunk(0);
+        } else {
+            std::vector<std::jthread> workers;
+            for (unsigned t = 0; t < threads; ++t)
+                workers.emplace_back(processChunk, t);
+        }
+
+        // 3. merge the sorted chunks pairwise
+        for (std::size_t width = 1; width < threads; width *= 2)
+            for (std::size_t t = 0; t + width < threads; t += 2 * width)
+                std::inplace_merge(entries.begin() + bounds[t],
+                                   entries.begin() + bounds[t + width],
+                                   entries.begin() + bounds[std::min<std::size_t>(t + 2 * width, threads)],
+                                   detail::keyLess);
+
+        // 4. permute the originals into key order
+        std::vector<std::string> sorted;
+        sorted.reserve(count);
+        for (detail::Entry& entry : entries)
+            sorted.push_back(std::move(words[entry.index]));
+        words = std::move(sorted);
+    }
+}
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Format strings parsed once, at compile time.
+// std::format checks its format string at compile time, but the check is thrown away: every call parses
+// the string again, type-erases the arguments into format_args and dispatches on them at run time.
+// compiled::format<"...">(args...) splits the string into literal and argument segments during
+// compilation, including the format spec of every field. A call is then a fixed sequence of appends:
+// literals are copied, integers, floating point numbers and strings are written with std::to_chars or a
+// copy and padded as the spec says. Other types and the rarer options (locale 'L', '#' for floating
+// point, hex floats, non-ASCII fill) go through std::formatter, one field at a time. Dynamic width and
+// precision ("{:{}}") are not supported.
+//
+//     std::string line = compiled::format<"worker {} processed {} items in {:.2f} ms">(id, count, ms);
+//     compiled::format_to<"{}={}\n">(std::back_inserter(out), key, value);
+namespace compiled
+{
+    // A string literal usable as a template argument.
+    template <std::size_t N>
+    struct FixedString {
+        char data[N]{};
+
+        constexpr FixedString(const char (&text)[N])
+        {
+            std::copy_n(text, N, data);
+        }
+
+        constexpr std::string_view view() const { return {data, N - 1}; }
+    };
+
+    namespace detail
+    {
+        // The standard format spec [[fill]align][sign][#][0][width][.precision][L][type], split at compile time.
+        // simple is false for anything only std::formatter handles: a non-ASCII fill, 'L', a type longer
+        // than one character.
+        struct Spec {
+            char fill = ' ';
+            char align = 0; // '<', '>', '^' or 0 for the default of the type
+            char sign = 0;  // '+', '-', ' ' or 0
+            bool alternate = false;
+            bool zero = false;
+            int width = 0;
+            int precision = -1;
+            char type = 0;
+            bool simple = true;
+        };
+
+        struct Segment {
+            int argument = -1; // -1 for a literal
+            std::size_t begin = 0; // literal text or "{:spec}" in Parsed::text
+            std::size_t length = 0;
+            Spec spec;
+        };
+
+        // Literals are stored unescaped ("{{" becomes "{"), a field with a spec as the one-argument
+        // format string "{:spec}". Neither is longer than its source, so the text fits in N characters.
+        template <std::size_t N>
+        struct Parsed {
+            std::array<Segment, N> segments{};
+            std::size_t count = 0;
+            std::array<char, N> text{};
+            std::size_t textSize = 0;
+            std::size_t literalSize = 0;
+            int arguments = 0;
+            bool valid = true;
+        };
+
+        constexpr bool isAlign(char c) { return c == '<' || c == '>' || c == '^'; }
+
+        constexpr Spec parseSpec(std::string_view text)
+        {
+            Spec spec;
+            std::size_t i = 0;
+            auto number = [&] {
+                int value = 0;
+                for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i)
+                    value = value * 10 + (text[i] - '0');
+                return value;
+            };
+
+            if (text.size() >= 2 && isAlign(text[1])) {
+                spec.fill = text[0];
+                spec.align = text[1];
+                spec.simple = static_cast<unsigned char>(text[0]) < 0x80;
+                i = 2;
+            } else if (!text.empty() && isAlign(text[0])) {
+                spec.align = text[0];
+                i = 1;
+            }
+            if (i < text.size() && (text[i] == '+' || text[i] == '-' || text[i] == ' '))
+                spec.sign = text[i++];
+            if (i < text.size() && text[i] == '#')
+                spec.alternate = text[i++] == '#';
+            if (i < text.size() && text[i] == '0')
+                spec.zero = text[i++] == '0';
+            spec.width = number();
+            if (i < text.size() && text[i] == '.') {
+                ++i;
+                spec.precision = number();
+            }
+            if (i < text.size() && text[i] == 'L')
+                spec.simple = false;
+            else if (i < text.size())
+                spec.type = text[i++];
+            spec.simple = spec.simple && i == text.size();
+            return spec;
+        }
+
+        template <std::size_t N>
+        constexpr Parsed<N> parse(std::string_view format)
+        {
+            Parsed<N> parsed;
+            int nextArgument = 0;
+
+            auto appendText = [&](std::string_view text) {
+                for (char c : text)
+                    parsed.text[parsed.textSize++] = c;
+            };
+            auto appendLiteral = [&](std::string_view text) {
+                Segment* last = parsed.count > 0 ? &parsed.segments[parsed.count - 1] : nullptr;
+                if (last == nullptr || last->argument >= 0)
+                    parsed.segments[parsed.count++] = {-1, parsed.textSize, 0};
+                parsed.segments[parsed.count - 1].length += text.size();
+                parsed.literalSize += text.size();
+                appendText(text);
+            };
+
+            for (std::size_t i = 0; i < format.size(); ++i) {
+                char c = format[i];
+                if (c == '}') {
+                    // std::format_string rejects a single '}', here it only has to be skipped.
+                    appendLiteral("}");
+                    i += i + 1 < format.size() && format[i + 1] == '}';
+                    continue;
+                }
+                if (c != '{') {
+                    appendLiteral(format.substr(i, 1));
+                    continue;
+                }
+                if (i + 1 < format.size() && format[i + 1] == '{') {
+                    appendLiteral("{");
+                    ++i;
+                    continue;
+                }
+
+                std::size_t close = format.find('}', i);
+                if (close == std::string_view::npos)
+                    return parsed.valid = false, parsed;
+                std::string_view field = format.substr(i + 1, close - i - 1);
+                std::size_t colon = field.find(':');
+                std::string_view id = field.substr(0, colon);
+                std::string_view spec = colon == std::string_view::npos ? std::string_view{} : field.substr(colon + 1);
+                if (spec.find('{') != std::string_view::npos)
+                    return parsed.valid = false, parsed;
+
+                int argument = 0;
+                if (id.empty()) {
+                    argument = nextArgument++;
+                } else {
+                    for (char digit : id)
+                        argument = argument * 10 + (digit - '0');
+                }
+                parsed.arguments = std::max(parsed.arguments, argument + 1);
+
+                Segment segment{argument, parsed.textSize, 0};
+                if (!spec.empty()) {
+                    appendText("{:");
+                    appendText(spec);
+                    appendText("}");
+                    segment.length = parsed.textSize - segment.begin;
+                    segment.spec = parseSpec(spec);
+                }
+                parsed.segments[parsed.count++] = segment;
+                i = close;
+            }
+            return parsed;
+        }
+
+        // Output through an iterator, with a memcpy fast path for char buffers.
+        template <typename Out>
+        struct IteratorSink {
+            Out out;
+
+            void append(std::string_view text)
+            {
+                if constexpr (std::is_same_v<Out, char*>)
+                    out = static_cast<char*>(std::memcpy(out, text.data(), text.size())) + text.size();
+                else
+                    out = std::copy(text.begin(), text.end(), out);
+            }
+
+            void fill(std::size_t count, char c) { out = std::fill_n(out, count, c); }
+
+            template <typename T>
+            void vformat(std::string_view format, const T& value)
+            {
+                out = std::vformat_to(out, format, std::make_format_args(value));
+            }
+        };
+
+        // Output appended to a string, literals use std::string::append instead of one push_back per char.
+        struct StringSink {
+            std::string& out;
+
+            void append(std::string_view text) { out.append(text); }
+
+            void fill(std::size_t count, char c) { out.append(count, c); }
+
+            template <typename T>
+            void vformat(std::string_view format, const T& value)
+            {
+                std::vformat_to(std::back_inserter(out), format, std::make_format_args(value));
+            }
+        };
+
+        template <typename T>
+        concept Text = std::convertible_to<const T&, std::string_view> && !std::same_as<std::remove_cvref_t<T>, std::nullptr_t>;
+
+        // "{}" without a spec, the same output as std::format.
+        template <typename Sink, typename T>
+        void appendValue(Sink& sink, const T& value)
+        {
+            if constexpr (std::same_as<T, bool>) {
+                sink.append(value ? "true" : "false");
+            } else if constexpr (std::same_as<T, char>) {
+                sink.append(std::string_view(&value, 1));
+            } else if constexpr (std::integral<T> || std::floating_point<T>) {
+                char buffer[std::floating_point<T> ? 128 : 48]; // long double in shortest form, 128 bit integers
+                auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                sink.append(std::string_view(buffer, static_cast<std::size_t>(end - buffer)));
+            } else if constexpr (Text<T>) {
+                sink.append(std::string_view(value));
+            } else {
+                sink.vformat("{}", value);
+            }
+        }
+
+        // Writes prefix (sign and base prefix) and body padded to the width of the spec. Only called for
+        // ASCII text, where the width in columns is the number of bytes.
+        template <typename Sink>
+        void appendPadded(Sink& sink, const Spec& spec, std::string_view prefix, std::string_view body, char defaultAlign)
+        {
+            std::size_t size = prefix.size() + body.size();
+            std::size_t padding = static_cast<std::size_t>(spec.width) > size ? spec.width - size : 0;
+            if (padding == 0) {
+                sink.append(prefix);
+                sink.append(body);
+            } else if (spec.zero && spec.align == 0) {
+                sink.append(prefix);
+                sink.fill(padding, '0');
+                sink.append(body);
+            } else {
+                char align = spec.align != 0 ? spec.align : defaultAlign;
+                std::size_t before = align == '>' ? padding : (align == '^' ? padding / 2 : 0);
+                sink.fill(before, spec.fill);
+                sink.append(prefix);
+                sink.append(body);
+                sink.fill(padding - before, spec.fill);
+            }
+        }
+
+        constexpr bool isIntegerType(char type)
+        {
+            return type == 0 || type == 'd' || type == 'x' || type == 'X' || type == 'b' || type == 'B' || type == 'o';
+        }
+
+        constexpr bool isFloatType(char type)
+        {
+            return type == 0 || type == 'f' || type == 'F' || type == 'e' || type == 'E' || type == 'g' || type == 'G';
+        }
+
+        template <typename Char>
+        constexpr Char toUpper(Char c) { return c >= 'a' && c <= 'z' ? static_cast<Char>(c - 'a' + 'A') : c; }
+
+        // A field with a spec: written directly when the spec only pads, aligns, sets the sign, base or
+        // precision of a number or string, otherwise formatted by std::formatter. Returns false for the
+        // second case.
+        template <Spec spec, typename Sink, typename T>
+        bool appendFormatted(Sink& sink, const T& value)
+        {
+            if constexpr (!spec.simple) {
+                return false;
+            } else if constexpr (std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char>) {
+                if constexpr (!isIntegerType(spec.type) || spec.precision >= 0) {
+                    return false;
+                } else {
+                    constexpr int base = spec.type == 'x' || spec.type == 'X' ? 16 : spec.type == 'b' || spec.type == 'B' ? 2 : spec.type == 'o' ? 8 : 10;
+                    char digits[136]; // 128 bit integers in binary
+                    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, base);
+                    std::string_view body(digits, static_cast<std::size_t>(end - digits));
+                    if constexpr (spec.type == 'X')
+                        std::transform(digits, end, digits, toUpper<char>);
+
+                    char prefix[3];
+                    std::size_t prefixSize = 0;
+                    if (body.front() == '-') {
+                        prefix[prefixSize++] = '-';
+                        body.remove_prefix(1);
+                    } else if (spec.sign == '+' || spec.sign == ' ') {
+                        prefix[prefixSize++] = spec.sign;
+                    }
+                    if constexpr (spec.alternate && base != 10) {
+                        if (base != 8)
+                            prefix[prefixSize++] = '0', prefix[prefixSize++] = spec.type;
+                        else if (value != 0)
+                            prefix[prefixSize++] = '0';
+                    }
+                    appendPadded(sink, spec, std::string_view(prefix, prefixSize), body, '>');
+                    return true;
+                }
+            } else if constexpr (std::floating_point<T>) {
+                if constexpr (!isFloatType(spec.type) || spec.alternate) {
+                    return false;
+                } else {
+                    constexpr char lower = static_cast<char>(spec.type | 0x20);
+                    constexpr std::chars_format format = lower == 'f' ? std::chars_format::fixed
+                                                       : lower == 'e' ? std::chars_format::scientific
+                                                                      : std::chars_format::general;
+                    constexpr int precision = spec.precision >= 0 ? spec.precision : 6;
+                    char digits[512];
+                    std::to_chars_result result;
+                    if constexpr (spec.type == 0 && spec.precision < 0)
+                        result = std::to_chars(digits, digits + sizeof(digits), value);
+                    else
+                        result = std::to_chars(digits, digits + sizeof(digits), value, format, precision);
+                    if (result.ec != std::errc{})
+                        return false; // a very long fixed precision
+                    std::string_view body(digits, static_cast<std::size_t>(result.ptr - digits));
+                    if constexpr (spec.type == 'F' || spec.type == 'E' || spec.type == 'G')
+                        std::transform(digits, result.ptr, digits, toUpper<char>);
+
+                    char prefix = 0;
+                    if (body.front() == '-') {
+                        prefix = '-';
+                        body.remove_prefix(1);
+                    } else if (spec.sign == '+' || spec.sign == ' ') {
+                        prefix = spec.sign;
+                    }
+                    Spec finite = spec;
+                    finite.zero = spec.zero && std::isfinite(value); // no zero padding for inf and nan
+                    appendPadded(sink, finite, std::string_view(&prefix, prefix != 0), body, '>');
+                    return true;
+                }
+            } else if constexpr (Text<T>) {
+                if constexpr ((spec.type != 0 && spec.type != 's') || spec.sign != 0 || spec.alternate || spec.zero) {
+                    return false;
+                } else {
+                    std::string_view text(value);
+                    if constexpr (spec.precision >= 0)
+                        text = text.substr(0, spec.precision);
+                    if constexpr (spec.width > 0 || spec.precision >= 0) {
+                        // Column widths of non-ASCII text follow the Unicode rules of std::format.
+                        if (std::any_of(text.begin(), text.end(), [](char c) { return static_cast<unsigned char>(c) >= 0x80; }))
+                            return false;
+                    }
+                    appendPadded(sink, spec, {}, text, '<');
+                    return true;
+                }
+            } else {
+                return false;
+            }
+        }
+
+        template <FixedString Format>
+        inline constexpr auto kParsed = parse<sizeof(Format.data)>(Format.view());
+
+        template <FixedString Format, typename Sink, typename... Args>
+        void formatInto(Sink& sink, const Args&... args)
+        {
+            constexpr const auto& parsed = kParsed<Format>;
+            static_assert(parsed.valid, "unterminated field, or dynamic width/precision which compiled::format does not support");
+            static_assert(parsed.arguments <= static_cast<int>(sizeof...(Args)), "format string refers to a missing argument");
+
+            // The same compile time check as std::format: field types and specs must match the arguments.
+            [[maybe_unused]] constexpr std::format_string<const Args&...> check(Format.view());
+
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                auto arguments = std::forward_as_tuple(args...);
+                auto appendSegment = [&]<std::size_t S>(std::integral_constant<std::size_t, S>) {
+                    constexpr Segment segment = kParsed<Format>.segments[S];
+                    constexpr std::string_view text(kParsed<Format>.text.data() + segment.begin, segment.length);
+                    if constexpr (segment.argument < 0)
+                        sink.append(text);
+                    else if constexpr (segment.length == 0)
+                        appendValue(sink, std::get<segment.argument>(arguments));
+                    else if (!appendFormatted<segment.spec>(sink, std::get<segment.argument>(arguments)))
+                        sink.vformat(text, std::get<segment.argument>(arguments));
+                };
+                (appendSegment(std::integral_constant<std::size_t, I>{}), ...);
+            }(std::make_index_sequence<parsed.count>{});
+        }
+    }
+
+    // Number of literal characters in the format string, a lower bound for the output size.
+    template <FixedString Format>
+    inline constexpr std::size_t literal_size = detail::kParsed<Format>.literalSize;
+
+    template <FixedString Format, typename... Args>
+    std::string format(const Args&... args)
+    {
+        std::string result;
+        result.reserve(literal_size<Format> + 16 * sizeof...(Args));
+        detail::StringSink sink{result};
+        detail::formatInto<Format>(sink, args...);
+        return result;
+    }
+
+    template <FixedString Format, typename Out, typename... Args>
+    Out format_to(Out out, const Args&... args)
+    {
+        detail::IteratorSink<Out> sink{out};
+        detail::formatInto<Format>(sink, args...);
+        return sink.out;
+    }
+
+    // Appends to an existing string, the reused-buffer counterpart of format_to(std::back_inserter(s), ...).
+    template <FixedString Format, typename... Args>
+    std::string& format_append(std::string& out, const Args&... args)
+    {
+        detail::StringSink sink{out};
+        detail::formatInto<Format>(sink, args...);
+        return out;
+    }
+}
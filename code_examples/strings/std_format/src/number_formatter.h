@@ -0,0 +1,258 @@
+#pragma once
+
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <locale>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Locale-aware numbers and money written into a caller buffer.
+// std::format(loc, "{:L}") and an imbued stream look up the numpunct/moneypunct facets of the locale
+// for every value, the stream also needs a sentry and an allocated string per result. NumberFormatter
+// copies the punctuation out of the facets once, then formats with std::to_chars and inserts the
+// separators itself: no stream, no facet lookup and no allocation per value.
+// Like std::to_chars, every function returns {end, errc{}} or {last, errc::value_too_large}.
+namespace localized
+{
+    class NumberFormatter
+    {
+    public:
+        // international selects the ISO currency symbol ("EUR ") instead of the local one ("€"),
+        // like the second argument of std::put_money.
+        explicit NumberFormatter(const std::locale& locale, bool international = true)
+        {
+            const auto& numpunct = std::use_facet<std::numpunct<char>>(locale);
+            m_number = {numpunct.decimal_point(), numpunct.thousands_sep(), numpunct.grouping()};
+
+            if (international)
+                snapshotMoney(std::use_facet<std::moneypunct<char, true>>(locale));
+            else
+                snapshotMoney(std::use_facet<std::moneypunct<char, false>>(locale));
+        }
+
+        template <std::integral Integer>
+        std::to_chars_result format(char* first, char* last, Integer value) const
+        {
+            char digits[48]; // enough for 128 bit integers
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+            return localize(first, last, std::string_view(digits, end - digits), m_number);
+        }
+
+        // Shortest round trip representation, the same digits as std::format("{:L}", value).
+        template <std::floating_point Float>
+        std::to_chars_result format(char* first, char* last, Float value) const
+        {
+            char digits[64];
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+            return localize(first, last, std::string_view(digits, end - digits), m_number);
+        }
+
+        // Fixed notation with the given number of decimals, like std::format("{:.{}Lf}", value, precision).
+        template <std::floating_point Float>
+        std::to_chars_result format(char* first, char* last, Float value, int precision) const
+        {
+            char digits[400]; // DBL_MAX in fixed notation has 309 integer digits, longer results report the error
+            auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+            if (ec != std::errc{})
+                return {last, ec};
+            return localize(first, last, std::string_view(digits, end - digits), m_number);
+        }
+
+        // units is the amount in the smallest currency unit (cents), as passed to std::put_money.
+        // The currency symbol is always written, like std::showbase.
+        template <std::integral Integer>
+        std::to_chars_result formatMoney(char* first, char* last, Integer amount) const
+        {
+            bool negative = false;
+            if constexpr (std::is_signed_v<Integer>)
+                negative = amount < 0;
+            // Conversion to unsigned is modulo 2^64, so 0 - x is the magnitude even for the most negative value.
+            unsigned long long magnitude = static_cast<unsigned long long>(amount);
+            if (negative)
+                magnitude = 0ULL - magnitude;
+            return formatMoney(first, last, negative, magnitude);
+        }
+
+        // Rounded to whole units, like std::put_money(long double).
+        // Amounts beyond the range of unsigned long long, infinity and NaN report value_too_large.
+        template <std::floating_point Float>
+        std::to_chars_result formatMoney(char* first, char* last, Float units) const
+        {
+            Float rounded = std::nearbyint(units);
+            Float magnitude = std::fabs(rounded);
+            if (!(magnitude < static_cast<Float>(18446744073709551616.0L))) // 2^64
+                return {last, std::errc::value_too_large};
+            return formatMoney(first, last, rounded < 0, static_cast<unsigned long long>(magnitude));
+        }
+
+        char decimalPoint() const { return m_number.decimalPoint; }
+        char thousandsSeparator() const { return m_number.thousandsSeparator; }
+        const std::string& currencySymbol() const { return m_currencySymbol; }
+
+    private:
+        std::to_chars_result formatMoney(char* first, char* last, bool negative, unsigned long long magnitude) const
+        {
+            char digits[24];
+            char* end = std::to_chars(digits, digits + sizeof(digits), magnitude).ptr;
+            std::string_view value(digits, end - digits);
+
+            const std::string& sign = negative ? m_negativeSign : m_positiveSign;
+            const std::money_base::pattern& pattern = negative ? m_negativeFormat : m_positiveFormat;
+
+            char* out = first;
+            for (char part : pattern.field) {
+                switch (static_cast<std::money_base::part>(part)) {
+                    case std::money_base::symbol:
+                        out = append(out, last, m_currencySymbol);
+                        break;
+                    case std::money_base::sign:
+                        if (!sign.empty())
+                            out = append(out, last, std::string_view(sign).substr(0, 1));
+                        break;
+                    case std::money_base::value:
+                        out = writeMoneyValue(out, last, value);
+                        break;
+                    case std::money_base::space:
+                        out = append(out, last, " ");
+                        break;
+                    case std::money_base::none:
+                        break;
+                }
+                if (out == nullptr)
+                    return {last, std::errc::value_too_large};
+            }
+
+            // A sign longer than one character is split: the first character goes where the pattern puts
+            // the sign, the rest follows the whole amount (e.g. the closing parenthesis of "()").
+            if (sign.size() > 1 && (out = append(out, last, std::string_view(sign).substr(1))) == nullptr)
+                return {last, std::errc::value_too_large};
+            return {out, std::errc{}};
+        }
+
+        struct Punctuation {
+            char decimalPoint = '.';
+            char thousandsSeparator = ',';
+            std::string grouping; // group sizes from the right, the last one repeats, CHAR_MAX or <= 0 stops grouping
+        };
+
+        template <typename MoneyPunct>
+        void snapshotMoney(const MoneyPunct& moneypunct)
+        {
+            m_money = {moneypunct.decimal_point(), moneypunct.thousands_sep(), moneypunct.grouping()};
+            m_currencySymbol = moneypunct.curr_symbol();
+            m_positiveSign = moneypunct.positive_sign();
+            m_negativeSign = moneypunct.negative_sign();
+            m_positiveFormat = moneypunct.pos_format();
+            m_negativeFormat = moneypunct.neg_format();
+            // Real currencies use at most 3 decimals, the limit keeps writeMoneyValue within its stack buffer.
+            int fracDigits = moneypunct.frac_digits();
+            m_fracDigits = static_cast<std::size_t>(fracDigits < 0 ? 0 : (fracDigits > 20 ? 20 : fracDigits));
+        }
+
+        static std::size_t groupSize(const std::string& grouping, std::size_t index)
+        {
+            if (grouping.empty())
+                return 0;
+            char size = grouping[index < grouping.size() ? index : grouping.size() - 1];
+            return (size <= 0 || size == CHAR_MAX) ? 0 : static_cast<std::size_t>(size);
+        }
+
+        static char* append(char* out, char* last, std::string_view text)
+        {
+            if (out == nullptr || static_cast<std::size_t>(last - out) < text.size())
+                return nullptr;
+            return std::char_traits<char>::copy(out, text.data(), text.size()) + text.size();
+        }
+
+        // Writes the integer digits with a separator between the groups, nullptr when it does not fit.
+        static char* writeGrouped(char* out, char* last, std::string_view digits, const Punctuation& punct)
+        {
+            std::size_t separators = 0;
+            for (std::size_t remaining = digits.size(), index = 0;; ++index) {
+                std::size_t group = groupSize(punct.grouping, index);
+                if (group == 0 || remaining <= group)
+                    break;
+                remaining -= group;
+                ++separators;
+            }
+            if (static_cast<std::size_t>(last - out) < digits.size() + separators)
+                return nullptr;
+
+            // Fill from the right, where the groups start.
+            char* end = out + digits.size() + separators;
+            char* write = end;
+            std::size_t remaining = digits.size();
+            for (std::size_t index = 0; index < separators; ++index) {
+                std::size_t group = groupSize(punct.grouping, index);
+                write -= group;
+                remaining -= group;
+                std::char_traits<char>::copy(write, digits.data() + remaining, group);
+                *--write = punct.thousandsSeparator;
+            }
+            std::char_traits<char>::copy(out, digits.data(), remaining);
+            return end;
+        }
+
+        // Rewrites the output of std::to_chars: groups the integer part, replaces the decimal point and
+        // copies the exponent unchanged. "inf" and "nan" have no digits and are copied as they are.
+        static std::to_chars_result localize(char* first, char* last, std::string_view digits, const Punctuation& punct)
+        {
+            char* out = first;
+            if (!digits.empty() && digits.front() == '-') {
+                out = append(out, last, "-");
+                digits.remove_prefix(1);
+            }
+
+            std::size_t integerEnd = digits.find_first_not_of("0123456789");
+            if (integerEnd == std::string_view::npos)
+                integerEnd = digits.size();
+            out = out ? writeGrouped(out, last, digits.substr(0, integerEnd), punct) : nullptr;
+            digits.remove_prefix(integerEnd);
+
+            if (!digits.empty() && digits.front() == '.') {
+                out = append(out, last, std::string_view(&punct.decimalPoint, 1));
+                digits.remove_prefix(1);
+            }
+            out = append(out, last, digits);
+
+            if (out == nullptr)
+                return {last, std::errc::value_too_large};
+            return {out, std::errc{}};
+        }
+
+        // The money amount: grouped whole units, then frac_digits decimals, padded with zeros.
+        // Amounts below one unit get a leading zero ("0,05"), libstdc++'s put_money writes ",05".
+        char* writeMoneyValue(char* out, char* last, std::string_view digits) const
+        {
+            char padded[48];
+            if (digits.size() <= m_fracDigits) {
+                std::size_t zeros = m_fracDigits + 1 - digits.size();
+                std::char_traits<char>::assign(padded, zeros, '0');
+                std::char_traits<char>::copy(padded + zeros, digits.data(), digits.size());
+                digits = std::string_view(padded, zeros + digits.size());
+            }
+
+            std::size_t integerDigits = digits.size() - m_fracDigits;
+            out = writeGrouped(out, last, digits.substr(0, integerDigits), m_money);
+            if (m_fracDigits > 0) {
+                out = append(out, last, std::string_view(&m_money.decimalPoint, 1));
+                out = append(out, last, digits.substr(integerDigits));
+            }
+            return out;
+        }
+
+        Punctuation m_number;
+        Punctuation m_money;
+        std::string m_currencySymbol;
+        std::string m_positiveSign;
+        std::string m_negativeSign;
+        std::money_base::pattern m_positiveFormat{};
+        std::money_base::pattern m_negativeFormat{};
+        std::size_t m_fracDigits = 0;
+    };
+}
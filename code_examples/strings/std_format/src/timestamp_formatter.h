@@ -0,0 +1,156 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+
+// Fast "YYYY-MM-DD HH:MM:SS" timestamps in a time zone, written into a caller buffer.
+// std::format("{:%Y-%m-%d %H:%M:%S}", zoned_time) looks up the zone transition, converts the days
+// to a calendar date and parses the format string on every call. Log timestamps arrive in order and
+// mostly within the same minute, so this formatter caches:
+// - the time zone pointer, resolved by name once
+// - the current sys_info (UTC offset and the interval it is valid for)
+// - the text of the current local minute "YYYY-MM-DD HH:MM:", only the seconds are written per call
+namespace timestamp
+{
+    class ZonedFormatter
+    {
+    public:
+        static constexpr std::size_t kSize = 19;       // "YYYY-MM-DD HH:MM:SS"
+        static constexpr std::size_t kMillisSize = 23; // "YYYY-MM-DD HH:MM:SS.mmm"
+
+        explicit ZonedFormatter(const std::chrono::time_zone* zone)
+            : m_zone(zone)
+        {
+        }
+
+        // Throws std::runtime_error when the zone is not in the time zone database.
+        explicit ZonedFormatter(std::string_view zoneName)
+            : m_zone(std::chrono::locate_zone(zoneName))
+        {
+        }
+
+        const std::chrono::time_zone* zone() const { return m_zone; }
+
+        // Writes kSize characters, the time point is truncated to whole seconds like floor<seconds>.
+        // Years are expected in [0, 9999], like the four digit %Y of std::format.
+        template <typename Duration>
+        std::size_t format(std::chrono::sys_time<Duration> time, char* buffer)
+        {
+            using namespace std::chrono;
+            sys_seconds seconds = floor<std::chrono::seconds>(time);
+            long long local = toLocalSeconds(seconds);
+
+            // Refresh the minute prefix only when the local minute changes.
+            long long minute = floorDiv(local, 60);
+            if (minute != m_minute) {
+                m_minute = minute;
+                writeMinutePrefix(minute);
+            }
+
+            std::char_traits<char>::copy(buffer, m_prefix, kPrefixSize);
+            write2(buffer + kPrefixSize, static_cast<unsigned>(local - minute * 60));
+            return kSize;
+        }
+
+        // Writes kMillisSize characters.
+        template <typename Duration>
+        std::size_t formatMillis(std::chrono::sys_time<Duration> time, char* buffer)
+        {
+            using namespace std::chrono;
+            std::size_t size = format(time, buffer);
+            auto millis = floor<milliseconds>(time) - floor<std::chrono::seconds>(time);
+            unsigned ms = static_cast<unsigned>(millis.count());
+            buffer[size] = '.';
+            buffer[size + 1] = static_cast<char>('0' + ms / 100);
+            write2(buffer + size + 2, ms % 100);
+            return kMillisSize;
+        }
+
+        template <typename Duration>
+        std::string toString(std::chrono::sys_time<Duration> time)
+        {
+            char buffer[kSize];
+            return std::string(buffer, format(time, buffer));
+        }
+
+    private:
+        static constexpr std::size_t kPrefixSize = 17; // "YYYY-MM-DD HH:MM:"
+
+        static long long floorDiv(long long value, long long divisor)
+        {
+            long long quotient = value / divisor;
+            return (value % divisor < 0) ? quotient - 1 : quotient;
+        }
+
+        static void write2(char* out, unsigned value)
+        {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+        }
+
+        // The offset is only looked up again when the time leaves the interval of the cached sys_info,
+        // i.e. at a daylight saving transition.
+        long long toLocalSeconds(std::chrono::sys_seconds seconds)
+        {
+            if (!m_infoValid || seconds < m_info.begin || seconds >= m_info.end) {
+                m_info = m_zone->get_info(seconds);
+                m_infoValid = true;
+            }
+            return (seconds + m_info.offset).time_since_epoch().count();
+        }
+
+        void writeMinutePrefix(long long minute)
+        {
+            using namespace std::chrono;
+            local_seconds local{std::chrono::seconds{minute * 60}};
+            local_days day = floor<days>(local);
+            year_month_day date{day};
+            hh_mm_ss<std::chrono::seconds> clock{local - day};
+
+            int year = static_cast<int>(date.year());
+            write2(m_prefix, static_cast<unsigned>(year / 100 % 100));
+            write2(m_prefix + 2, static_cast<unsigned>(year % 100));
+            m_prefix[4] = '-';
+            write2(m_prefix + 5, static_cast<unsigned>(date.month()));
+            m_prefix[7] = '-';
+            write2(m_prefix + 8, static_cast<unsigned>(date.day()));
+            m_prefix[10] = ' ';
+            write2(m_prefix + 11, static_cast<unsigned>(clock.hours().count()));
+            m_prefix[13] = ':';
+            write2(m_prefix + 14, static_cast<unsigned>(clock.minutes().count()));
+            m_prefix[16] = ':';
+        }
+
+        const std::chrono::time_zone* m_zone;
+        std::chrono::sys_info m_info{};
+        bool m_infoValid = false;
+        long long m_minute = std::numeric_limits<long long>::min(); // no minute cached yet
+        char m_prefix[kPrefixSize] = {};
+    };
+
+    // One formatter per zone name. A log pipeline only uses a handful of zones, so a linear search over
+    // the names is cheaper than hashing them. The deque keeps returned references valid when zones are added.
+    class ZoneCache
+    {
+    public:
+        ZonedFormatter& get(std::string_view zoneName)
+        {
+            for (Entry& entry : m_entries)
+                if (entry.name == zoneName)
+                    return entry.formatter;
+            return m_entries.emplace_back(std::string(zoneName), ZonedFormatter(zoneName)).formatter;
+        }
+
+    private:
+        struct Entry {
+            std::string name;
+            ZonedFormatter formatter;
+        };
+
+        std::deque<Entry> m_entries;
+    };
+}